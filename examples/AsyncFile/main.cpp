@@ -0,0 +1,445 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: main.cpp
+ * Created: 17th October 2026 10:14:21 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 17th October 2026 10:14:21 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+/*
+**************
+** includes **
+**************
+*/
+
+#include <RxCW/AsyncFile.h>
+#include <RxCW/FileSystem.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(RXCW_ENABLE_IO_URING)
+#include <RxCW/IOUring.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+void	log(const std::string& pValue)
+{
+	std::cout << "[thread " << std::this_thread::get_id() << "] " << pValue << std::endl;
+}
+
+// the tests run one after the other, each one waits for its operations to complete
+void	waitFor(Completable completable)
+{
+	std::promise<void>	done;
+
+	completable.subscribe([&done]() {
+		log("completed !");
+		done.set_value();
+	}, [&done](std::exception_ptr e) {
+		try
+		{
+			std::rethrow_exception(e);
+		}
+		catch (const std::exception& exception)
+		{
+			log(std::string("error: ") + exception.what());
+		}
+		done.set_value();
+	});
+	done.get_future().wait();
+}
+
+// end the file, and delete it from the rxEnd callback once nothing runs on it anymore
+Completable	closeFile(AsyncFile* file)
+{
+	return file->rxEnd()
+		.doOnTerminate([file]() {
+			delete file;
+		});
+}
+
+// write the given data to a new file, then close it
+void	writeFile(const std::string& path, const std::string& data)
+{
+	AsyncFile*	file = FileSystem::open(path, "w");
+
+	waitFor(file->rxWrite(data).andThen(closeFile(file)));
+}
+
+// read a whole file, the chunks being delivered to the handler
+Completable	readFile(AsyncFile* file, const std::function<void(const Buffer&)>& handler)
+{
+	return Completable::create([file, handler](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
+	{
+		file->exceptionHandler(onError);
+		file->handler(handler);
+		file->endHandler(onComplete);
+		file->resume();
+	});
+}
+
+void	test_asyncfile_read()
+{
+	log("START\tAsyncFile read test");
+	writeFile("async_file_read.txt", std::string(64 * 1024, 'a'));
+
+	AsyncFile*			file = FileSystem::open("async_file_read.txt", "r");
+	size_t				size = 0;
+
+	// the chunks are read on a thread of the IOScheduler pool, shared by every file
+	waitFor(readFile(file, [&size](const Buffer& data) {
+		size += data.size();
+	}).andThen(closeFile(file)));
+	log("read " + std::to_string(size) + " bytes");
+	FileSystem::remove("async_file_read.txt");
+	log("END\tAsyncFile read test");
+	log("");
+}
+
+void	test_asyncfile_io_uring()
+{
+	log("START\tAsyncFile io_uring test");
+#if defined(RXCW_ENABLE_IO_URING)
+	IOUring*	ring = IOUring::get();
+
+	// AsyncFile goes through the ring by itself, and falls back to stdio calls when io_uring is not available
+	log(std::string("io_uring is ") + (ring ? "available" : "not available"));
+	writeFile("async_file_io_uring.txt", "Hello io_uring!");
+	if (ring)
+	{
+		int						fd = ::open("async_file_io_uring.txt", O_RDONLY);
+		char					data[64];
+		std::promise<ssize_t>	done;
+
+		// the completion function runs on the ring thread
+		ring->read(fd, data, sizeof(data), 0, [&done](ssize_t result) {
+			done.set_value(result);
+		});
+
+		ssize_t	result = done.get_future().get();
+
+		if (result >= 0)
+			log("read from the ring: " + std::string(data, result));
+		::close(fd);
+	}
+
+	AsyncFile*	file = FileSystem::open("async_file_io_uring.txt", "r");
+
+	waitFor(readFile(file, [](const Buffer& data) {
+		log("read from AsyncFile: " + data.toString());
+	}).andThen(closeFile(file)));
+	FileSystem::remove("async_file_io_uring.txt");
+#else
+	log("built without io_uring, see the --ioUring option of scripts/cmake.py");
+#endif
+	log("END\tAsyncFile io_uring test");
+	log("");
+}
+
+void	test_asyncfile_mapped()
+{
+	log("START\tAsyncFile memory mapped test");
+#if !defined(_WIN32)
+	std::string	content;
+
+	for (size_t i = 0; content.size() < 3 * 1024 * 1024; i++)
+		content += std::to_string(i) + "\n";
+	writeFile("async_file_mapped.txt", content);
+
+	// the chunks are views on the mapping, read without any copy
+	AsyncFile*	file = FileSystem::open("async_file_mapped.txt", "rm");
+	std::string	read;
+	size_t		chunks = 0;
+
+	waitFor(readFile(file, [&read, &chunks](const Buffer& data) {
+		read.append(data.data(), data.size());
+		chunks++;
+	}).andThen(closeFile(file)));
+	log("read " + std::to_string(read.size()) + " bytes in " + std::to_string(chunks) + " chunks, "
+		+ (read == content ? "same content" : "different content !"));
+	FileSystem::remove("async_file_mapped.txt");
+#else
+	log("memory mapped mode is not supported on Windows");
+#endif
+	log("END\tAsyncFile memory mapped test");
+	log("");
+}
+
+void	test_asyncfile_write_queue()
+{
+	log("START\tAsyncFile write queue test");
+
+	AsyncFile*	file = FileSystem::open("async_file_write_queue.txt", "w");
+	Buffer		chunk(std::string(1024, 'w'));
+
+	file->setWriteQueueMaxSize(4);
+	// a writer ignoring writeQueueFull is not failed, the writes beyond the queue wait for it to drain
+	for (size_t i = 0; i < 64; i++)
+		file->write(chunk);
+	log("queue full after 64 writes: " + std::to_string(file->writeQueueFull()));
+
+	// a well behaved writer stops once the queue is full, and goes on from the drain handler
+	std::mutex				mutex;
+	size_t					written = 0;
+	size_t					drains = 0;
+	std::promise<void>		done;
+	std::function<void()>	writeMore = [&]() {
+		std::lock_guard<std::mutex>	lock(mutex);
+
+		if (written == 256)
+			return ;
+		while (written < 256 && !file->writeQueueFull())
+		{
+			file->write(chunk);
+			written++;
+		}
+		if (written == 256)
+			done.set_value();
+	};
+
+	file->drainHandler([&]() {
+		drains++;
+		writeMore();
+	});
+	writeMore();
+	done.get_future().wait();
+	waitFor(closeFile(file));
+	log("wrote " + std::to_string(FileSystem::fileSize("async_file_write_queue.txt")) + " bytes, the queue drained "
+		+ std::to_string(drains) + " times");
+	FileSystem::remove("async_file_write_queue.txt");
+	log("END\tAsyncFile write queue test");
+	log("");
+}
+
+void	test_asyncfile_vectored_write()
+{
+	log("START\tAsyncFile vectored write test");
+
+	AsyncFile*								file = FileSystem::open("async_file_vectored.txt", "w");
+	std::string								content;
+	std::chrono::steady_clock::time_point	start = std::chrono::steady_clock::now();
+
+	// the small writes pending at the same time are gathered in vectored writes of up to 256 KiB
+	file->setWriteBatchSize(256 * 1024);
+	file->setWriteQueueMaxSize(1024);
+	for (size_t i = 0; i < 10000; i++)
+	{
+		std::string	line = "line " + std::to_string(i) + "\n";
+
+		content += line;
+		file->write(Buffer(line));
+	}
+	waitFor(closeFile(file));
+
+	std::chrono::microseconds	elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	log("wrote 10000 lines in " + std::to_string(elapsed.count()) + " us, "
+		+ (FileSystem::fileSize("async_file_vectored.txt") == content.size() ? "same size" : "different size !"));
+	FileSystem::remove("async_file_vectored.txt");
+	log("END\tAsyncFile vectored write test");
+	log("");
+}
+
+void	test_asyncfile_positional()
+{
+	log("START\tAsyncFile positional read and write test");
+
+	AsyncFile*	file = FileSystem::open("async_file_positional.txt", "w+");
+
+	// positional transfers leave the file position alone, and can be in flight at the same time
+	waitFor(file->rxWriteAt(6, Buffer("world"))
+		.andThen(file->rxWriteAt(0, Buffer("hello "))));
+	waitFor(file->rxReadAt(0, 11)
+		.flatMapCompletable([](const Buffer& data) {
+			log("read at 0: \"" + data.toString() + "\"");
+			return Completable::complete();
+		})
+		.andThen(closeFile(file)));
+	FileSystem::remove("async_file_positional.txt");
+	log("END\tAsyncFile positional read and write test");
+	log("");
+}
+
+void	test_asyncfile_kernel_copy()
+{
+	log("START\tAsyncFile kernel copy test");
+	writeFile("async_file_copy_source.txt", std::string(4 * 1024 * 1024, 'c'));
+
+	AsyncFile*	source = FileSystem::open("async_file_copy_source.txt", "r");
+	AsyncFile*	destination = FileSystem::open("async_file_copy_destination.txt", "w");
+
+	// between two files, the data is copied by the kernel without going through user space when possible
+	waitFor(source->rxPipeTo(*destination, [](uint64_t copied) {
+			log("copied " + std::to_string(copied) + " bytes");
+		})
+		.andThen(closeFile(source))
+		.andThen(closeFile(destination)));
+	log("destination size: " + std::to_string(FileSystem::fileSize("async_file_copy_destination.txt")));
+	FileSystem::remove("async_file_copy_source.txt");
+	FileSystem::remove("async_file_copy_destination.txt");
+	log("END\tAsyncFile kernel copy test");
+	log("");
+}
+
+void	test_asyncfile_adaptive_read()
+{
+	log("START\tAsyncFile adaptive read test");
+	writeFile("async_file_adaptive.txt", std::string(2 * 1024 * 1024, 'r'));
+
+	AsyncFile*	file = FileSystem::open("async_file_adaptive.txt", "r");
+	size_t		chunkSize = 0;
+
+	// the chunks grow while the consumer keeps up, and shrink when it pauses the file
+	file->setAdaptiveReadBufferSize(4096, 256 * 1024);
+	waitFor(readFile(file, [&chunkSize](const Buffer& data) {
+		if (data.size() != chunkSize)
+			log("chunk size: " + std::to_string(data.size()));
+		chunkSize = data.size();
+	}).andThen(closeFile(file)));
+	FileSystem::remove("async_file_adaptive.txt");
+	log("END\tAsyncFile adaptive read test");
+	log("");
+}
+
+void	test_asyncfile_direct()
+{
+	log("START\tAsyncFile direct test");
+#if defined(__linux__)
+	std::string	content(3 * AsyncFile::DIRECT_IO_ALIGNMENT + 100, 'd');
+
+	try
+	{
+		// the transfers bypass the page cache, the last partial block is written when the file is ended
+		AsyncFile*	file = FileSystem::open("async_file_direct.txt", "wd");
+
+		waitFor(file->rxWrite(content).andThen(closeFile(file)));
+		file = FileSystem::open("async_file_direct.txt", "rd");
+
+		std::string	read;
+
+		waitFor(readFile(file, [&read](const Buffer& data) {
+			read.append(data.data(), data.size());
+		}).andThen(closeFile(file)));
+		log("read " + std::to_string(read.size()) + " bytes, " + (read == content ? "same content" : "different content !"));
+	}
+	catch (const std::system_error& e)
+	{
+		// some file systems, such as tmpfs, don't support O_DIRECT
+		log(std::string("can't open the file in direct mode: ") + e.what());
+	}
+	FileSystem::remove("async_file_direct.txt");
+#else
+	log("direct mode is only supported on Linux");
+#endif
+	log("END\tAsyncFile direct test");
+	log("");
+}
+
+void	test_asyncfile_sync_policy()
+{
+	log("START\tAsyncFile sync policy test");
+
+	AsyncFile*				file = FileSystem::open("async_file_sync.txt", "w");
+	AsyncFile::SyncPolicy	policy;
+
+	// sync every 256 KiB, or 20 ms after a write, and once more before closing
+	policy.bytes = 256 * 1024;
+	policy.interval = std::chrono::milliseconds(20);
+	policy.syncOnEnd = true;
+	file->setSyncPolicy(policy);
+	file->setWriteQueueMaxSize(64);
+	for (size_t i = 0; i < 16; i++)
+		file->write(Buffer(std::string(64 * 1024, 's')));
+	// completes once everything written so far is durable, sharing the sync of the policy if one is pending
+	waitFor(file->rxSync());
+	log("1 MiB durable");
+	waitFor(closeFile(file));
+	FileSystem::remove("async_file_sync.txt");
+	log("END\tAsyncFile sync policy test");
+	log("");
+}
+
+void	test_asyncfile_concurrent_writers()
+{
+	log("START\tAsyncFile concurrent writers test");
+
+	AsyncFile*					file = FileSystem::open("async_file_concurrent.txt", "w");
+	std::vector<std::thread>	writers;
+
+	// the methods can be called from any thread, the work is handed over to the file strand
+	for (size_t i = 0; i < 4; i++)
+		writers.emplace_back([file, i]() {
+			for (size_t j = 0; j < 1000; j++)
+				file->write(Buffer("writer " + std::to_string(i) + "\n"));
+		});
+	for (std::thread& writer : writers)
+		writer.join();
+	waitFor(closeFile(file));
+	log("wrote " + std::to_string(FileSystem::fileSize("async_file_concurrent.txt")) + " bytes, expected "
+		+ std::to_string(4 * 1000 * std::string("writer 0\n").size()));
+	FileSystem::remove("async_file_concurrent.txt");
+	log("END\tAsyncFile concurrent writers test");
+	log("");
+}
+
+int		main(int argc, char **argv)
+{
+	test_asyncfile_read();
+	test_asyncfile_io_uring();
+	test_asyncfile_mapped();
+	test_asyncfile_write_queue();
+	test_asyncfile_vectored_write();
+	test_asyncfile_positional();
+	test_asyncfile_kernel_copy();
+	test_asyncfile_adaptive_read();
+	test_asyncfile_direct();
+	test_asyncfile_sync_policy();
+	test_asyncfile_concurrent_writers();
+	return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: main.cpp
+ * Created: 17th October 2026 11:47:08 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 17th October 2026 11:47:08 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+/*
+**************
+** includes **
+**************
+*/
+
+#include <RxCW/AsyncFile.h>
+#include <RxCW/FileSystem.h>
+#include <RxCW/IOScheduler.h>
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+void	log(const std::string& pValue)
+{
+	std::cout << "[thread " << std::this_thread::get_id() << "] " << pValue << std::endl;
+}
+
+// subscribe to the Completable, the returned future being ready once it terminates
+std::future<void>	start(Completable completable)
+{
+	std::shared_ptr<std::promise<void>>	done = std::make_shared<std::promise<void>>();
+
+	completable.subscribe([done]() {
+		log("completed !");
+		done->set_value();
+	}, [done](std::exception_ptr e) {
+		try
+		{
+			std::rethrow_exception(e);
+		}
+		catch (const std::exception& exception)
+		{
+			log(std::string("error: ") + exception.what());
+		}
+		done->set_value();
+	});
+	return done->get_future();
+}
+
+// the tests run one after the other, each one waits for its operations to complete
+void	waitFor(Completable completable)
+{
+	start(completable).wait();
+}
+
+// end the file, and delete it from the rxEnd callback once nothing runs on it anymore
+Completable	closeFile(AsyncFile* file)
+{
+	return file->rxEnd()
+		.doOnTerminate([file]() {
+			delete file;
+		});
+}
+
+// write the given data to a new file, then close it
+void	writeFile(const std::string& path, const std::string& data)
+{
+	AsyncFile*	file = FileSystem::open(path, "w");
+
+	waitFor(file->rxWrite(data).andThen(closeFile(file)));
+}
+
+void	test_filesystem_read_chunks()
+{
+	log("START\tFileSystem rxReadChunks test");
+#if !defined(_WIN32)
+	std::string	content;
+
+	for (size_t i = 0; content.size() < 4 * 1024 * 1024; i++)
+		content += std::to_string(i) + "\n";
+	writeFile("filesystem_read_chunks.txt", content);
+
+	// up to 4 chunks of 256 KiB are read at the same time, and emitted in file order
+	std::string	read;
+
+	waitFor(FileSystem::rxReadChunks("filesystem_read_chunks.txt", 256 * 1024, 4)
+		.doOnSuccess([&read](const Buffer& chunk) {
+			read.append(chunk.data(), chunk.size());
+		})
+		.ignoreElements());
+	log("read " + std::to_string(read.size()) + " bytes, " + (read == content ? "same content" : "different content !"));
+	FileSystem::remove("filesystem_read_chunks.txt");
+#else
+	log("rxReadChunks is not supported on Windows");
+#endif
+	log("END\tFileSystem rxReadChunks test");
+	log("");
+}
+
+void	test_filesystem_blocking_pool()
+{
+	log("START\tFileSystem blocking calls pool test");
+
+	// the blocking calls run on the IOScheduler blocking calls pool, the caller thread is never blocked
+	waitFor(FileSystem::rxMkdirs("filesystem_pool/a/b")
+		.andThen(FileSystem::rxExists("filesystem_pool/a/b")
+			.flatMapCompletable([](bool exists) {
+				log("exists: " + std::to_string(exists));
+				return Completable::complete();
+			})));
+
+	// the results can be delivered somewhere else, such as the caller's event loop
+	FileSystem::Schedulers	schedulers(IOScheduler::blockingScheduler(), rxcpp::schedulers::make_new_thread());
+
+	waitFor(FileSystem::rxRemoveRecursive("filesystem_pool", schedulers)
+		.andThen(FileSystem::rxExists("filesystem_pool", schedulers)
+			.flatMapCompletable([](bool exists) {
+				log("exists after removal: " + std::to_string(exists));
+				return Completable::complete();
+			})));
+	log("END\tFileSystem blocking calls pool test");
+	log("");
+}
+
+void	test_filesystem_walk()
+{
+	log("START\tFileSystem rxWalk test");
+	FileSystem::mkdirs("filesystem_walk/a/skipped");
+	FileSystem::mkdirs("filesystem_walk/b");
+	writeFile("filesystem_walk/a/1.txt", "1");
+	writeFile("filesystem_walk/a/2.log", "2");
+	writeFile("filesystem_walk/a/skipped/3.txt", "3");
+	writeFile("filesystem_walk/b/4.txt", "4");
+
+	// only the text files are emitted, and the skipped directory is not walked into
+	FileSystem::WalkOptions	options;
+
+	options.filter = [](const FileSystem::DirEntry& entry) {
+		return entry.type == FileSystem::DirEntry::Type::FILE && entry.name.size() > 4 && entry.name.substr(entry.name.size() - 4) == ".txt";
+	};
+	options.descend = [](const FileSystem::DirEntry& entry) {
+		return entry.name != "skipped";
+	};
+	waitFor(FileSystem::rxWalk("filesystem_walk", options)
+		.doOnSuccess([](const FileSystem::DirEntry& entry) {
+			log("walked: " + entry.path + " at depth " + std::to_string(entry.depth));
+		})
+		.ignoreElements());
+
+	// rxList only lists the directory itself
+	waitFor(FileSystem::rxList("filesystem_walk")
+		.doOnSuccess([](const FileSystem::DirEntry& entry) {
+			log("listed: " + entry.name + (entry.type == FileSystem::DirEntry::Type::DIRECTORY ? "/" : ""));
+		})
+		.ignoreElements());
+	FileSystem::removeRecursive("filesystem_walk");
+	log("END\tFileSystem rxWalk test");
+	log("");
+}
+
+void	logProgress(const std::string& operation, const FileSystem::Progress& progress)
+{
+	log(operation + ": " + std::to_string(progress.files) + " files, " + std::to_string(progress.directories) + " directories, "
+		+ std::to_string(progress.bytes) + " bytes");
+}
+
+void	test_filesystem_recursive_copy_remove()
+{
+	log("START\tFileSystem recursive copy and remove test");
+	for (size_t i = 0; i < 4; i++)
+	{
+		std::string	directory = "filesystem_tree/" + std::to_string(i) + "/sub";
+
+		FileSystem::mkdirs(directory);
+		for (size_t j = 0; j < 8; j++)
+			writeFile(directory + "/" + std::to_string(j) + ".txt", std::string(1024 * (j + 1), 'x'));
+	}
+
+	// 4 directories are handled at the same time, the progress being emitted periodically and once more at the end
+	waitFor(FileSystem::rxCopyRecursive("filesystem_tree", "filesystem_tree_copy", 4)
+		.doOnSuccess([](const FileSystem::Progress& progress) {
+			logProgress("copied", progress);
+		})
+		.ignoreElements());
+	waitFor(FileSystem::rxRemoveRecursive("filesystem_tree", 4)
+		.doOnSuccess([](const FileSystem::Progress& progress) {
+			logProgress("removed", progress);
+		})
+		.ignoreElements());
+	waitFor(FileSystem::rxRemoveRecursive("filesystem_tree_copy", 4)
+		.doOnSuccess([](const FileSystem::Progress& progress) {
+			logProgress("removed the copy", progress);
+		})
+		.ignoreElements());
+	log("END\tFileSystem recursive copy and remove test");
+	log("");
+}
+
+void	test_filesystem_metadata_cache()
+{
+	log("START\tFileSystem metadata cache test");
+	writeFile("filesystem_stat_1.txt", "1");
+	writeFile("filesystem_stat_2.txt", "22");
+
+	// the files are stated by batches, a missing file being reported in its result instead of failing
+	waitFor(FileSystem::rxStatMany({ "filesystem_stat_1.txt", "filesystem_stat_2.txt", "filesystem_stat_missing.txt" })
+		.doOnSuccess([](const FileSystem::StatResult& result) {
+			if (result.exists)
+				log(result.path + ": " + std::to_string(result.size) + " bytes");
+			else
+				log(result.path + ": error " + std::to_string(result.error));
+		})
+		.ignoreElements());
+
+	// the status is kept for a second, the changes made through an open file are only seen once it expires
+	FileSystem::setMetadataCache(std::chrono::seconds(1));
+
+	AsyncFile*	file = FileSystem::open("filesystem_stat_1.txt", "a");
+
+	log("size: " + std::to_string(FileSystem::fileSize("filesystem_stat_1.txt")));
+	waitFor(file->rxWrite("more data").andThen(closeFile(file)));
+	log("cached size after writing: " + std::to_string(FileSystem::fileSize("filesystem_stat_1.txt")));
+	FileSystem::invalidateMetadata("filesystem_stat_1.txt");
+	log("size after invalidating it: " + std::to_string(FileSystem::fileSize("filesystem_stat_1.txt")));
+	FileSystem::setMetadataCache(std::chrono::milliseconds(0));
+	FileSystem::remove("filesystem_stat_1.txt");
+	FileSystem::remove("filesystem_stat_2.txt");
+	log("END\tFileSystem metadata cache test");
+	log("");
+}
+
+void	test_filesystem_watch()
+{
+	log("START\tFileSystem rxWatch test");
+#if defined(__linux__)
+	FileSystem::mkdirs("filesystem_watch/sub");
+
+	// the changes of a path are coalesced until it stays unchanged for 50 ms, the subdirectories are watched too
+	std::future<void>	watched = start(FileSystem::rxWatch("filesystem_watch", FileSystem::FsEvent::ALL, true, std::chrono::milliseconds(50))
+		.doOnSuccess([](const FileSystem::FsEvent& event) {
+			std::string	types;
+
+			if (event.types & FileSystem::FsEvent::CREATED)
+				types += " created";
+			if (event.types & FileSystem::FsEvent::MODIFIED)
+				types += " modified";
+			if (event.types & FileSystem::FsEvent::REMOVED)
+				types += " removed";
+			log(event.path + (event.directory ? "/" : "") + types);
+		})
+		.take(3)
+		.ignoreElements());
+
+	// the watch is set up asynchronously, keep on changing files until it reported 3 of them
+	for (size_t i = 0; watched.wait_for(std::chrono::milliseconds(200)) != std::future_status::ready; i++)
+		writeFile("filesystem_watch/sub/file_" + std::to_string(i) + ".txt", "watched");
+	FileSystem::removeRecursive("filesystem_watch");
+#else
+	log("rxWatch is only supported on Linux");
+#endif
+	log("END\tFileSystem rxWatch test");
+	log("");
+}
+
+int		main(int argc, char **argv)
+{
+	test_filesystem_read_chunks();
+	test_filesystem_blocking_pool();
+	test_filesystem_walk();
+	test_filesystem_recursive_copy_remove();
+	test_filesystem_metadata_cache();
+	test_filesystem_watch();
+	return 0;
+}
@@ -0,0 +1,397 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: main.cpp
+ * Created: 17th October 2026 11:02:57 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 17th October 2026 11:02:57 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+/*
+**************
+** includes **
+**************
+*/
+
+#include <RxCW/AsyncFile.h>
+#include <RxCW/Buffer.h>
+#include <RxCW/BufferPool.h>
+#include <RxCW/Checksum.h>
+#include <RxCW/ChecksumStream.h>
+#include <RxCW/CompressStream.h>
+#include <RxCW/DecompressStream.h>
+#include <RxCW/FileSystem.h>
+#include <RxCW/LineReadStream.h>
+#include <RxCW/Pipe.h>
+#include <RxCW/ThrottledStream.h>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+void	log(const std::string& pValue)
+{
+	std::cout << "[thread " << std::this_thread::get_id() << "] " << pValue << std::endl;
+}
+
+// subscribe to the Completable, the returned future being ready once it terminates
+std::future<void>	start(Completable completable)
+{
+	std::shared_ptr<std::promise<void>>	done = std::make_shared<std::promise<void>>();
+
+	completable.subscribe([done]() {
+		log("completed !");
+		done->set_value();
+	}, [done](std::exception_ptr e) {
+		try
+		{
+			std::rethrow_exception(e);
+		}
+		catch (const std::exception& exception)
+		{
+			log(std::string("error: ") + exception.what());
+		}
+		done->set_value();
+	});
+	return done->get_future();
+}
+
+// the tests run one after the other, each one waits for its operations to complete
+void	waitFor(Completable completable)
+{
+	start(completable).wait();
+}
+
+// end the file, and delete it from the rxEnd callback once nothing runs on it anymore
+Completable	closeFile(AsyncFile* file)
+{
+	return file->rxEnd()
+		.doOnTerminate([file]() {
+			delete file;
+		});
+}
+
+// write the given data to a new file, then close it
+void	writeFile(const std::string& path, const std::string& data)
+{
+	AsyncFile*	file = FileSystem::open(path, "w");
+
+	waitFor(file->rxWrite(data).andThen(closeFile(file)));
+}
+
+// read a whole stream, the chunks being delivered to the handler
+Completable	readStream(ReadStream<Buffer>& stream, const std::function<void(const Buffer&)>& handler)
+{
+	return Completable::create([&stream, handler](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
+	{
+		stream.exceptionHandler(onError);
+		stream.handler(handler);
+		stream.endHandler(onComplete);
+		stream.resume();
+	});
+}
+
+void	test_buffer()
+{
+	log("START\tBuffer test");
+
+	Buffer	buffer("Hello world!");
+	Buffer	hello = buffer.slice(0, 5);
+	Buffer	world = buffer.slice(6);
+
+	// slices share the allocation of the Buffer they come from
+	log("slices: \"" + hello.toString() + "\" and \"" + world.toString() + "\", sharing the memory: "
+		+ std::to_string(std::as_const(hello).data() == std::as_const(buffer).data()));
+	buffer.data()[0] = 'J';
+	log("after writing to the Buffer: \"" + hello.toString() + "\"");
+
+	// a Buffer can also view memory owned by another object, the object is kept alive with the Buffer
+	std::shared_ptr<std::string>	owner = std::make_shared<std::string>("owned by a string");
+	Buffer							view(owner, owner->data(), owner->size());
+
+	owner.reset();
+	log("view: \"" + view.toString() + "\"");
+	log("END\tBuffer test");
+	log("");
+}
+
+void	test_buffer_pool()
+{
+	log("START\tBufferPool test");
+
+	Buffer		buffer = BufferPool::acquire(64 * 1024);
+	const char*	block = std::as_const(buffer).data();
+
+	// the block goes back to the pool with the last Buffer using it, and is handed out again
+	buffer = Buffer();
+	buffer = BufferPool::acquire(60 * 1024);
+	log("block reused: " + std::to_string(std::as_const(buffer).data() == block));
+
+	// a block released by another thread goes back to the thread that acquired it
+	Buffer*	released = new Buffer(BufferPool::acquire(100));
+
+	block = std::as_const(*released).data();
+	std::thread([released]() {
+		delete released;
+	}).join();
+
+	Buffer	small = BufferPool::acquire(200);
+
+	log("small block reused after being released by another thread: " + std::to_string(std::as_const(small).data() == block));
+	log("END\tBufferPool test");
+	log("");
+}
+
+void	test_line_read_stream()
+{
+	log("START\tLineReadStream test");
+	writeFile("line_read_stream.txt", "first line\r\nsecond line\n\nlast line, without a line feed");
+
+	// the lines held by a single chunk are slices of it, only the lines spanning several chunks are copied
+	AsyncFile*		file = FileSystem::open("line_read_stream.txt", "r");
+	LineReadStream	lines(*file);
+
+	file->setReadBufferSize(16);
+	waitFor(readStream(lines, [](const Buffer& line) {
+		log("line: \"" + line.toString() + "\"");
+	}).andThen(closeFile(file)));
+	FileSystem::remove("line_read_stream.txt");
+	log("END\tLineReadStream test");
+	log("");
+}
+
+void	test_gzip()
+{
+	log("START\tgzip test");
+#if defined(RXCW_ENABLE_ZLIB)
+	std::string	content;
+
+	for (size_t i = 0; content.size() < 2 * 1024 * 1024; i++)
+		content += "line " + std::to_string(i) + "\n";
+
+	// compress to a file, 256 KiB blocks being compressed by 4 threads at the same time
+	AsyncFile*			output = FileSystem::open("streams.gz", "w");
+	CompressStream		compress(CompressStream::DEFAULT_LEVEL, 4, 256 * 1024);
+	std::future<void>	compressed = start(compress.rxPipeTo(*output).andThen(closeFile(output)));
+
+	for (size_t offset = 0; offset < content.size(); offset += 64 * 1024)
+		compress.write(Buffer(content.substr(offset, 64 * 1024)));
+	compress.end();
+	compressed.wait();
+	log("compressed " + std::to_string(content.size()) + " bytes to " + std::to_string(FileSystem::fileSize("streams.gz")));
+
+	// the file can be read by gunzip, or decompressed back
+	AsyncFile*			input = FileSystem::open("streams.gz", "r");
+	DecompressStream	decompress;
+	std::string			read;
+	std::future<void>	piped = start(input->rxPipeTo(decompress));
+
+	waitFor(readStream(decompress, [&read](const Buffer& data) {
+		read.append(data.data(), data.size());
+	}));
+	piped.wait();
+	waitFor(closeFile(input));
+	log("decompressed " + std::to_string(read.size()) + " bytes, " + (read == content ? "same content" : "different content !"));
+	FileSystem::remove("streams.gz");
+#else
+	log("built without zlib, see the --zlib option of scripts/cmake.py");
+#endif
+	log("END\tgzip test");
+	log("");
+}
+
+void	test_checksum()
+{
+	log("START\tChecksum test");
+
+	struct	Vector
+	{
+		Checksum::Algorithm	algorithm;
+		std::string			name;
+		std::string			data;
+		std::string			expected;
+	};
+
+	// published test vectors
+	std::vector<Vector>	vectors = {
+		{ Checksum::Algorithm::CRC32C, "CRC-32C", "123456789", "e3069283" },
+		{ Checksum::Algorithm::XXHASH64, "xxHash64", "", "ef46db3751d8e999" },
+		{ Checksum::Algorithm::XXHASH64, "xxHash64", "abc", "44bc2cf5ad770999" },
+		{ Checksum::Algorithm::SHA256, "SHA-256", "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" }
+	};
+
+	for (const Vector& vector : vectors)
+	{
+		Checksum	checksum(vector.algorithm);
+
+		checksum.update(vector.data.data(), vector.data.size());
+
+		std::string	digest = Checksum::toHex(checksum.digest());
+
+		log(vector.name + "(\"" + vector.data + "\") = " + digest + (digest == vector.expected ? " ok" : " expected " + vector.expected + " !"));
+	}
+
+	// the data is checksummed while being copied to another file, instead of being read a second time
+	std::string	content(1024 * 1024, 'x');
+	Checksum	expected(Checksum::Algorithm::CRC32C);
+
+	expected.update(content.data(), content.size());
+	writeFile("checksum_source.txt", content);
+
+	AsyncFile*			input = FileSystem::open("checksum_source.txt", "r");
+	AsyncFile*			output = FileSystem::open("checksum_destination.txt", "w");
+	ChecksumStream		checksum(Checksum::Algorithm::CRC32C);
+	std::future<void>	copied = start(checksum.rxPipeTo(*output).andThen(closeFile(output)));
+
+	waitFor(input->rxPipeTo(checksum)
+		.andThen(closeFile(input))
+		.andThen(checksum.rxDigest()
+			.flatMapCompletable([&expected](const Checksum::Digest& digest) {
+				log("copied with CRC-32C " + Checksum::toHex(digest) + ", expected " + Checksum::toHex(expected.digest()));
+				return Completable::complete();
+			})));
+	copied.wait();
+	FileSystem::remove("checksum_source.txt");
+	FileSystem::remove("checksum_destination.txt");
+	log("END\tChecksum test");
+	log("");
+}
+
+void	test_fan_out_pipe()
+{
+	log("START\tfan-out pipe test");
+	writeFile("fan_out_source.txt", std::string(2 * 1024 * 1024, 'f'));
+
+	AsyncFile*	input = FileSystem::open("fan_out_source.txt", "r");
+	AsyncFile*	first = FileSystem::open("fan_out_first.txt", "w");
+	AsyncFile*	second = FileSystem::open("fan_out_second.txt", "w");
+
+	// the source is paused while the first copy can't keep up, the second one queues up to 32 chunks in memory first
+	waitFor(input->rxPipeTo({ *first, { *second, ReadStream<Buffer>::Backpressure::SPILL, 32 } })
+		.andThen(closeFile(input))
+		.andThen(closeFile(first))
+		.andThen(closeFile(second)));
+	log("copies: " + std::to_string(FileSystem::fileSize("fan_out_first.txt")) + " and "
+		+ std::to_string(FileSystem::fileSize("fan_out_second.txt")) + " bytes");
+	FileSystem::remove("fan_out_source.txt");
+	FileSystem::remove("fan_out_first.txt");
+	FileSystem::remove("fan_out_second.txt");
+	log("END\tfan-out pipe test");
+	log("");
+}
+
+void	test_throttled_stream()
+{
+	log("START\tThrottledStream test");
+	writeFile("throttled_source.txt", std::string(256 * 1024, 't'));
+
+	AsyncFile*								input = FileSystem::open("throttled_source.txt", "r");
+	AsyncFile*								output = FileSystem::open("throttled_destination.txt", "w");
+	// copy at 128 KiB per second at most, after a burst of one second worth of data
+	ThrottledStream							throttle(128 * 1024);
+	std::chrono::steady_clock::time_point	begin = std::chrono::steady_clock::now();
+	std::future<void>						copied = start(throttle.rxPipeTo(*output).andThen(closeFile(output)));
+
+	waitFor(input->rxPipeTo(throttle).andThen(closeFile(input)));
+	copied.wait();
+	log("copied 256 KiB in " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count()) + " ms");
+	FileSystem::remove("throttled_source.txt");
+	FileSystem::remove("throttled_destination.txt");
+	log("END\tThrottledStream test");
+	log("");
+}
+
+void	test_pipe()
+{
+	log("START\tPipe test");
+
+	// move-only values go through the pipe without being copied
+	Pipe<std::unique_ptr<int>>	pipe(16);
+	std::mutex					mutex;
+	int							written = 0;
+	bool						ended = false;
+	long						sum = 0;
+	std::promise<void>			done;
+	std::function<void()>		writeMore = [&]() {
+		std::lock_guard<std::mutex>	lock(mutex);
+
+		while (written < 1000 && !pipe.writeStream().writeQueueFull())
+			pipe.writeStream().write(std::make_unique<int>(++written));
+		if (written == 1000 && !ended)
+		{
+			ended = true;
+			pipe.writeStream().end();
+		}
+	};
+
+	pipe.readStream().moveHandler([&sum](std::unique_ptr<int>&& value) {
+		sum += *value;
+	});
+	pipe.readStream().endHandler([&done]() {
+		done.set_value();
+	});
+	// the writer stops once 16 values are queued, and goes on once the reader drained them
+	pipe.writeStream().drainHandler(writeMore);
+	pipe.readStream().resume();
+	writeMore();
+	done.get_future().wait();
+	log("sum of the values read: " + std::to_string(sum));
+	log("END\tPipe test");
+	log("");
+}
+
+int		main(int argc, char **argv)
+{
+	test_buffer();
+	test_buffer_pool();
+	test_line_read_stream();
+	test_gzip();
+	test_checksum();
+	test_fan_out_pipe();
+	test_throttled_stream();
+	test_pipe();
+	return 0;
+}
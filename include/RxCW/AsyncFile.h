@@ -38,11 +38,25 @@
 */
 
 // RxCW
+#include <RxCW/Buffer.h>
 #include <RxCW/ReadStream.h>
+#include <RxCW/RingBuffer.h>
+#include <RxCW/Single.h>
 #include <RxCW/WriteStream.h>
 
 // stl
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <vector>
+
+// posix
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
 
 /*
 ****************
@@ -53,6 +67,7 @@
 namespace	RxCW
 {
 	class	FileSystem;
+	class	IOUring;
 }
 
 /*
@@ -66,8 +81,13 @@ namespace	RxCW
 	/**
 	 * @class AsyncFile AsyncFile.h RxCW/AsyncFile.h
 	 * @brief Allows to asynchronously read from and write to a file.
+	 * 
+	 * Every operation on the file runs on the same IOScheduler thread, its strand, so reads, writes, pause/resume and
+	 * close never run concurrently. The public methods only set atomic flags and hand the work over to the strand, they
+	 * can be called from any thread. Handlers are called on the strand. Destroying the file drops the operations still
+	 * queued on the strand, it may be destroyed once @ref rxEnd completed, from its callback included.
 	 */
-	class	AsyncFile : public ReadStream<std::string>, public WriteStream<std::string>
+	class	AsyncFile : public ReadStream<Buffer>, public WriteStream<Buffer>
 	{
 
 		/*
@@ -86,15 +106,69 @@ namespace	RxCW
 			***********
 			*/
 
+			/**
+			 * @brief Function called while piping, with the number of bytes transferred so far.
+			 */
+			typedef std::function<void(uint64_t)>	ProgressFunction;
+
+			/**
+			 * @brief When written data is made durable. The default policy never syncs the file by itself.
+			 */
+			struct	SyncPolicy
+			{
+				/**
+				 * @brief Sync once this many bytes were written since the last sync, 0 to disable.
+				 */
+				size_t						bytes = 0;
+				/**
+				 * @brief Sync this long after the first write following the last sync, 0 to disable.
+				 * Writes and @ref rxSync calls within this window share the same sync.
+				 */
+				std::chrono::milliseconds	interval = std::chrono::milliseconds(0);
+				/**
+				 * @brief Also sync the file metadata (fsync instead of fdatasync).
+				 */
+				bool						metadata = false;
+				/**
+				 * @brief Sync the file in @ref end, before closing it.
+				 */
+				bool						syncOnEnd = false;
+				/**
+				 * @brief Start the writeback of the written data every this many bytes, without waiting for it, 0 to disable.
+				 * Only supported on Linux (sync_file_range).
+				 */
+				size_t						flushBytes = 0;
+			};
+
 			/**
 			 * @brief The default read buffer size.
 			 * 
 			 */
 			static const size_t	DEFAULT_READ_BUFFER_SIZE = 4096;
+			/**
+			 * @brief The default maximum read buffer size in adaptive mode.
+			 */
+			static const size_t	DEFAULT_MAX_READ_BUFFER_SIZE = 1024 * 1024;
+			/**
+			 * @brief The number of consecutive chunks consumed without pausing after which the adaptive read buffer size doubles.
+			 */
+			static const size_t	ADAPTIVE_READ_GROWTH_STREAK = 4;
 			/**
 			 * @brief The default write queue size.
 			 */
 			static const size_t	DEFAULT_WRITE_QUEUE_SIZE = 16;
+			/**
+			 * @brief The default maximum number of bytes written by a single system call when several writes are pending.
+			 */
+			static const size_t	DEFAULT_WRITE_BATCH_SIZE = 64 * 1024;
+			/**
+			 * @brief The size of the window the kernel is asked to prefetch ahead of the read position, in memory mapped mode.
+			 */
+			static const size_t	MAPPED_READ_AHEAD_SIZE = 1024 * 1024;
+			/**
+			 * @brief The alignment of offsets, sizes and memory of the transfers in direct mode.
+			 */
+			static const size_t	DIRECT_IO_ALIGNMENT = 4096;
 
 			/*
 			*************
@@ -112,21 +186,21 @@ namespace	RxCW
 			 * 
 			 * @param handler The handler.
 			 */
-			virtual void		exceptionHandler(const StreamBase<std::string>::ErrorFunction& handler);
+			virtual void		exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler);
 
 			/**
 			 * @brief Set the handler to call when the file end is reached while reading.
 			 * 
 			 * @param handler The handler.
 			 */
-			virtual void		endHandler(const ReadStream<std::string>::EndFunction& handler);
+			virtual void		endHandler(const ReadStream<Buffer>::EndFunction& handler);
 
 			/**
 			 * @brief Set the handler to call for each block of data read.
 			 * 
 			 * @param handler The handler.
 			 */
-			virtual void		handler(const ReadStream<std::string>::DataFunction& handler);
+			virtual void		handler(const ReadStream<Buffer>::DataFunction& handler);
 
 			/**
 			 * @brief Pause the stream for reading.
@@ -138,27 +212,99 @@ namespace	RxCW
 			 */
 			virtual void		resume();
 
+			/**
+			 * @brief Asynchronously pipe this file to the given WriteStream.
+			 * 
+			 * @param writeStream The WriteStream to pipe this file to.
+			 * @return The resulting Completable.
+			 * 
+			 * @see rxPipeTo(WriteStream<Buffer>&, const ProgressFunction&)
+			 */
+			virtual Completable	rxPipeTo(WriteStream<Buffer>& writeStream);
+
+			using ReadStream<Buffer>::rxPipeTo;
+
+			/**
+			 * @brief Set the size of the chunks read from the file. Disables the adaptive mode.
+			 * 
+			 * @param size The read buffer size.
+			 */
+			virtual void		setReadBufferSize(size_t size);
+
+			/**
+			 * @brief Let the size of the chunks read from the file adapt to the consumer.
+			 * 
+			 * The size starts at minSize and doubles each time the consumer keeps up for @ref ADAPTIVE_READ_GROWTH_STREAK chunks
+			 * without pausing the stream, up to maxSize. Each pause halves it again, down to minSize.
+			 * 
+			 * @param minSize The minimum read buffer size.
+			 * @param maxSize The maximum read buffer size.
+			 */
+			virtual void		setAdaptiveReadBufferSize(size_t minSize = DEFAULT_READ_BUFFER_SIZE, size_t maxSize = DEFAULT_MAX_READ_BUFFER_SIZE);
+
+			/**
+			 * @brief Get the current size of the chunks read from the file.
+			 * 
+			 * @return size_t The read buffer size.
+			 */
+			virtual size_t		readBufferSize();
+
+			/**
+			 * @brief Asynchronously pipe this file to the given WriteStream, reporting progress.
+			 * 
+			 * On Linux, when the WriteStream is another AsyncFile with no pending write, the data is copied by the kernel
+			 * with copy_file_range or sendfile, without going through user space. Otherwise the data handler,
+			 * end handler and exception handler are replaced like with ReadStream::rxPipeTo.
+			 * 
+			 * @param writeStream The WriteStream to pipe this file to.
+			 * @param onProgress The function to call each time data is transferred, can be empty.
+			 * @return The resulting Completable.
+			 */
+			virtual Completable	rxPipeTo(WriteStream<Buffer>& writeStream, const ProgressFunction& onProgress);
+
 			/**
 			 * @brief Set the handler to call when data can be pushed to the write queue again.
 			 * 
 			 * @param handler The handler.
 			 */
-			virtual void		drainHandler(const WriteStream<std::string>::DrainFunction& handler);
+			virtual void		drainHandler(const WriteStream<Buffer>::DrainFunction& handler);
 
 			/**
-			 * @brief End writing.
+			 * @brief End writing. The file is closed once the pending writes are done.
 			 */
 			virtual void		end();
 
 			/**
-			 * @brief Write the given data to the file.
+			 * @brief Reactive version of the @ref end method.
+			 * 
+			 * @return Completable The resulting Completable, completing once the pending writes are done and the file is closed.
+			 */
+			virtual Completable	rxEnd();
+
+			/**
+			 * @brief Write the given data to the file. May be called from several threads, the data written by each one
+			 * keeps its order.
+			 * 
+			 * Past twice the write queue max size, the data waits in an overflow list until the queue drains, so a writer
+			 * ignoring @ref writeQueueFull only costs memory.
 			 * 
 			 * @param data The data to write to the file.
 			 */
-			virtual void		write(const std::string& data);
+			virtual void		write(const Buffer& data);
 
 			/**
-			 * @brief Set the write queue max size.
+			 * @brief Write the given data to the file, without copying it. May be called from several threads.
+			 * 
+			 * @param data The data to write to the file.
+			 * @throw std::logic_error The file is ended.
+			 */
+			virtual void		write(Buffer&& data);
+
+			/**
+			 * @brief Set the write queue max size. The queue holds up to twice this size before writes overflow.
+			 * 
+			 * The size is applied on the file strand, after the calls already posted to it, and the queue grows once the
+			 * pending writes are done.
 			 * 
 			 * @param size The write queue max size.
 			 */
@@ -172,6 +318,58 @@ namespace	RxCW
 			 */
 			virtual bool		writeQueueFull();
 
+			/**
+			 * @brief Set the maximum number of bytes written by a single system call when several writes are pending.
+			 * 
+			 * Pending writes are gathered in a single vectored write, up to this size. A single write bigger than this size
+			 * is still written at once. Only used by files opened for writing only, or with the io_uring backend.
+			 * 
+			 * @param size The maximum number of bytes.
+			 */
+			virtual void		setWriteBatchSize(size_t size);
+
+			/**
+			 * @brief Read data at the given position, without moving the stream position.
+			 * 
+			 * Positional reads don't go through the stream buffering and are not serialized with the stream operations,
+			 * several of them run in parallel on the IOScheduler threads. Not supported on Windows.
+			 * 
+			 * @param offset The position to read from.
+			 * @param length The number of bytes to read.
+			 * @return Single<Buffer> The data read, shorter than length if the end of the file was reached.
+			 */
+			virtual Single<Buffer>	rxReadAt(uint64_t offset, size_t length);
+
+			/**
+			 * @brief Write data at the given position, without moving the stream position.
+			 * 
+			 * Positional writes don't go through the stream buffering and are not serialized with the stream operations,
+			 * several of them run in parallel on the IOScheduler threads. On Linux, files opened in append mode ignore the position.
+			 * Not supported on Windows.
+			 * 
+			 * @param offset The position to write at.
+			 * @param data The data to write.
+			 * @return Completable The resulting Completable, completing once all the data is written.
+			 */
+			virtual Completable		rxWriteAt(uint64_t offset, const Buffer& data);
+
+			/**
+			 * @brief Set when written data is made durable. Must be set before writing to the file.
+			 * 
+			 * @param policy The sync policy.
+			 */
+			virtual void			setSyncPolicy(const SyncPolicy& policy);
+
+			/**
+			 * @brief Make the data written so far durable.
+			 * 
+			 * Waits for the pending writes, then syncs the file. With an interval policy, the sync happens at the end of the
+			 * current window, so that concurrent calls are grouped in a single sync.
+			 * 
+			 * @return Completable The resulting Completable, completing once the data written before the call is durable.
+			 */
+			virtual Completable		rxSync();
+
 		/*
 		************************************************************************
 		******************************* PROTECTED ******************************
@@ -180,6 +378,19 @@ namespace	RxCW
 
 		protected:
 
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			struct	SyncWaiter
+			{
+				uint64_t						target;
+				Completable::CompleteFunction	onComplete;
+				Completable::ErrorFunction		onError;
+			};
+
 			/*
 			*************
 			** methods **
@@ -223,6 +434,28 @@ namespace	RxCW
 
 			Completable	rxInternalRead();
 			Completable	rxInternalWrite();
+			void		readCompleted(const Buffer& buffer, size_t size, const Completable::CompleteFunction& onComplete);
+			void		mapFile();
+			void		unmapFile();
+			void		adviseReadAhead(bool sequential);
+			void		prefetchMapping();
+			void		prefetchFile();
+			void		writeCompleted(const Completable::CompleteFunction& onComplete);
+			bool		writeQueueDrained() const;
+			void		refillWriteQueue();
+			void		resizeWriteQueue();
+			bool		writesQueued();
+			size_t		prepareWriteVector();
+			void		consumeWritten(size_t size);
+			Completable	rxKernelCopyTo(AsyncFile& destination, const ProgressFunction& onProgress);
+			void		writeAt(uint64_t offset, const Buffer& data, const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError);
+			void		readDirect(const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError);
+			void		writeDirect(const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError);
+			int			flushDirect();
+			void		post(const std::function<void()>& action);
+			void		close();
+			void		syncIfNeeded();
+			int			syncFile();
 
 			/*
 			****************
@@ -230,22 +463,67 @@ namespace	RxCW
 			****************
 			*/
 
-			std::FILE*	_file;
-			bool		_closed;
-
-			size_t		_readBufferSize;
-			bool		_paused;
-			bool		_readEnded;
-
-			bool					_writeEnded;
-			size_t					_writeQueueSize;
-			bool					_writeQueueFull;
-			std::list<std::string>	_writeQueue;
-
-			StreamBase<std::string>::ErrorFunction	_errorHandler;
-			ReadStream<std::string>::EndFunction	_endHandler;
-			WriteStream<std::string>::DrainFunction	_drainHandler;
-			ReadStream<std::string>::DataFunction	_dataHandler;
+			std::FILE*						_file;
+			std::atomic<bool>				_closed;
+			// held shared by the positional reads and writes running off the strand, so the file can't be closed under them
+			std::shared_mutex				_closeMutex;
+			rxcpp::schedulers::scheduler	_scheduler;
+			rxcpp::composite_subscription	_lifetime;
+			rxcpp::schedulers::worker		_worker;
+			// the loops are scheduled on the worker through it, so that they stop with the file
+			rxcpp::schedulers::scheduler	_strand;
+
+			IOUring*						_ring;
+
+			bool						_mapped;
+			std::shared_ptr<const char>	_mapping;
+			size_t						_mappingSize;
+			size_t						_mappingOffset;
+			size_t						_mappingAdvisedEnd;
+
+			bool		_direct;
+			uint64_t	_directOffset;
+			Buffer		_directBuffer;
+			size_t		_directBuffered;
+
+			std::atomic<size_t>	_readBufferSize;
+			std::atomic<size_t>	_minReadBufferSize;
+			std::atomic<size_t>	_maxReadBufferSize;
+			size_t				_readStreak;
+			std::atomic<bool>	_paused;
+			std::atomic<bool>	_readEnded;
+			bool				_reading;
+
+			std::atomic<bool>					_writeEnded;
+			std::vector<std::pair<Completable::CompleteFunction, Completable::ErrorFunction>>	_endWaiters;
+			std::atomic<size_t>					_writeQueueSize;
+			std::atomic<bool>					_writeQueueFull;
+			std::atomic<bool>					_writing;
+			std::unique_ptr<RingBuffer<Buffer>>	_writeQueue;
+			// serializes the producers of the queue, and guards the writes overflowing it
+			std::mutex							_writeMutex;
+			std::deque<Buffer>					_writeOverflow;
+			std::atomic<size_t>					_writeOverflowSize;
+			std::atomic<size_t>					_writeBatchSize;
+			bool								_vectoredWrite;
+#if !defined(_WIN32)
+			std::vector<iovec>					_writeVector;
+#endif
+
+			StreamBase<Buffer>::ErrorFunction	_errorHandler;
+			ReadStream<Buffer>::EndFunction	_endHandler;
+			WriteStream<Buffer>::DrainFunction	_drainHandler;
+			ReadStream<Buffer>::DataFunction	_dataHandler;
+			SyncPolicy							_syncPolicy;
+			std::atomic<uint64_t>				_queuedBytes;
+			std::atomic<uint64_t>				_writtenBytes;
+			uint64_t							_syncedBytes;
+			uint64_t							_flushedBytes;
+			std::deque<SyncWaiter>				_syncWaiters;
+			bool								_syncScheduled;
+
+			ProgressFunction					_progressHandler;
+			uint64_t							_progress;
 
 	};
 }
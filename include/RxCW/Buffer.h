@@ -0,0 +1,235 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Buffer.h
+ * Created: 16th October 2026 2:41:05 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 2:41:05 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <memory>
+#include <string>
+#include <string_view>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class Buffer Buffer.h RxCW/Buffer.h
+	 * @brief A reference counted block of bytes used as stream chunk.
+	 * 
+	 * Copying or slicing a Buffer never copies the underlying bytes, all copies and slices share the same allocation,
+	 * which is released with the last of them.
+	 */
+	class	Buffer
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief Value used as length to slice until the end of the Buffer.
+			 */
+			static const size_t	npos = static_cast<size_t>(-1);
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct an empty Buffer.
+			 */
+			Buffer(void);
+
+			/**
+			 * @brief Construct a new Buffer with the given size. Its content is left uninitialized.
+			 * 
+			 * @param size The Buffer size.
+			 */
+			explicit Buffer(size_t size);
+
+			/**
+			 * @brief Construct a new Buffer holding a copy of the given data.
+			 * 
+			 * @param data The data to copy.
+			 * @param size The data size.
+			 */
+			Buffer(const char* data, size_t size);
+
+			/**
+			 * @brief Construct a new Buffer holding a copy of the given null terminated string.
+			 * 
+			 * @param data The string to copy.
+			 */
+			Buffer(const char* data);
+
+			/**
+			 * @brief Construct a new Buffer holding a copy of the given string.
+			 * 
+			 * @param data The string to copy.
+			 */
+			Buffer(const std::string& data);
+
+			/**
+			 * @brief Construct a new Buffer taking ownership of the given string, without copying it.
+			 * 
+			 * @param data The string to take.
+			 */
+			Buffer(std::string&& data);
+
+			/**
+			 * @brief Construct a new Buffer sharing the ownership of writable memory, without copying it.
+			 * 
+			 * @param data The data, released with the last Buffer or slice sharing it.
+			 * @param size The data size.
+			 */
+			Buffer(const std::shared_ptr<char>& data, size_t size);
+
+			/**
+			 * @brief Construct a new Buffer viewing memory owned by another object, without copying it.
+			 * 
+			 * The memory is read-only, such as a memory mapped file, the non-const @ref data copies it first.
+			 * 
+			 * @param owner The object owning the memory, kept alive as long as the Buffer or one of its slices exists.
+			 * @param data The data to view.
+			 * @param size The data size.
+			 */
+			Buffer(const std::shared_ptr<const void>& owner, const char* data, size_t size);
+
+			/**
+			 * @brief Destroy the Buffer object.
+			 */
+			~Buffer(void);
+
+			/**
+			 * @brief Get the Buffer data, to modify it.
+			 * 
+			 * The change is seen by the copies and slices sharing the allocation, except for a Buffer viewing read-only
+			 * memory, which first gets its own copy of the data.
+			 * 
+			 * @return char* The data.
+			 */
+			char*				data();
+
+			/**
+			 * @brief Get the Buffer data.
+			 * 
+			 * @return const char* The data.
+			 */
+			const char*			data() const;
+
+			/**
+			 * @brief Get the Buffer size.
+			 * 
+			 * @return size_t The size in bytes.
+			 */
+			size_t				size() const;
+
+			/**
+			 * @brief Checks if the Buffer is empty.
+			 * 
+			 * @return \b true: the Buffer is empty.
+			 * @return \b false: the Buffer is not empty.
+			 */
+			bool				empty() const;
+
+			/**
+			 * @brief Get a part of this Buffer, sharing the same allocation.
+			 * 
+			 * @param offset The offset of the part.
+			 * @param length The length of the part, truncated to the end of the Buffer.
+			 * @return Buffer The resulting Buffer.
+			 */
+			Buffer				slice(size_t offset, size_t length = npos) const;
+
+			/**
+			 * @brief Get a view of the Buffer data.
+			 * 
+			 * @return std::string_view The view, only valid while this Buffer exists.
+			 */
+			std::string_view	view() const;
+
+			/**
+			 * @brief Copy the Buffer data to a string.
+			 * 
+			 * @return std::string The resulting string.
+			 */
+			std::string			toString() const;
+
+			/**
+			 * @brief Copy the Buffer data to a string.
+			 * 
+			 * @return std::string The resulting string.
+			 */
+			operator			std::string() const;
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			std::shared_ptr<char>	_data;
+			size_t					_size;
+			// viewing memory owned by another object, which must not be written
+			bool					_readOnly;
+
+	};
+}
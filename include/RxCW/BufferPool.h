@@ -0,0 +1,217 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: BufferPool.h
+ * Created: 16th October 2026 11:02:13 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:02:13 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/Buffer.h>
+
+// stl
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class BufferPool BufferPool.h RxCW/BufferPool.h
+	 * @brief Pool of memory blocks streams can draw their chunks from, instead of allocating new ones.
+	 * 
+	 * Blocks are grouped by size classes, each a power of two between @ref MIN_BLOCK_SIZE and @ref MAX_BLOCK_SIZE.
+	 * A released block goes back to the cache of the thread that acquired it, then to a global cache shared by all threads
+	 * once that one is full. Blocks released by another thread are queued to the owner, which takes them back on its next
+	 * acquisition. Every Buffer of at least @ref BLOCK_ALIGNMENT bytes, pooled or not, is aligned on @ref BLOCK_ALIGNMENT
+	 * bytes, smaller ones are aligned on their block size.
+	 */
+	class	BufferPool
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The smallest block size.
+			 */
+			static const size_t	MIN_BLOCK_SIZE = 256;
+			/**
+			 * @brief The biggest block size, bigger Buffers are allocated outside of the pool.
+			 */
+			static const size_t	MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+			/**
+			 * @brief The alignment of every block.
+			 */
+			static const size_t	BLOCK_ALIGNMENT = 4096;
+			/**
+			 * @brief The default number of bytes kept by each thread.
+			 */
+			static const size_t	DEFAULT_THREAD_CACHE_SIZE = 4 * 1024 * 1024;
+			/**
+			 * @brief The default number of bytes kept in the global cache.
+			 */
+			static const size_t	DEFAULT_GLOBAL_CACHE_SIZE = 64 * 1024 * 1024;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Destroy the BufferPool object.
+			 */
+			virtual ~BufferPool(void);
+
+			/**
+			 * @brief Get a Buffer of the given size from the pool. Its content is left uninitialized.
+			 * 
+			 * The underlying block goes back to the pool once the Buffer and all its slices are released.
+			 * 
+			 * @param size The Buffer size.
+			 * @return Buffer The resulting Buffer.
+			 */
+			static Buffer	acquire(size_t size);
+
+			/**
+			 * @brief Set the number of bytes kept by each thread. Blocks released while it is full go to the global cache.
+			 * 
+			 * @param size The number of bytes, 0 sends every released block to the global cache.
+			 */
+			static void		setThreadCacheSize(size_t size);
+
+			/**
+			 * @brief Set the number of bytes kept in the global cache. Blocks released while it is full are freed.
+			 * 
+			 * @param size The number of bytes.
+			 */
+			static void		setGlobalCacheSize(size_t size);
+
+			/**
+			 * @brief Free every block of the global cache and of the calling thread cache.
+			 */
+			static void		clear();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			static const size_t	CLASS_COUNT = 17;
+
+			// the blocks released by other threads, waiting for their owner
+			struct	ReturnQueue
+			{
+				std::mutex							mutex;
+				std::vector<std::pair<char*, size_t>>	blocks;
+				std::atomic<size_t>					size{0};
+				bool								open = true;
+			};
+
+			struct	ThreadCache
+			{
+				ThreadCache(void);
+				~ThreadCache(void);
+
+				std::vector<char*>				blocks[CLASS_COUNT];
+				size_t							size = 0;
+				std::shared_ptr<ReturnQueue>	returns;
+			};
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new BufferPool object.
+			 */
+			BufferPool(void);
+
+			static size_t	sizeClass(size_t size);
+			static size_t	blockSize(size_t sizeClass);
+			static size_t	blockAlignment(size_t sizeClass);
+			static char*	allocate(size_t sizeClass);
+			static void		release(char* block, size_t sizeClass, const std::shared_ptr<ReturnQueue>& owner);
+			static void		releaseGlobal(char* block, size_t sizeClass);
+			static void		drain();
+			static void		free(char* block, size_t sizeClass);
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			static std::mutex			_mutex;
+			static std::vector<char*>	_blocks[CLASS_COUNT];
+			static size_t				_globalCacheSize;
+			static size_t				_globalCachedSize;
+			static std::atomic<size_t>	_threadCacheSize;
+
+			static thread_local ThreadCache	_threadCache;
+			static thread_local bool		_threadCacheDestroyed;
+
+	};
+}
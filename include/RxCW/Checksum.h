@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Checksum.h
+ * Created: 16th October 2026 1:37:15 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 1:37:15 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/Buffer.h>
+
+// stl
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class Checksum Checksum.h RxCW/Checksum.h
+	 * @brief Incrementally computes the checksum of a sequence of chunks.
+	 */
+	class	Checksum
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The checksum algorithms.
+			 */
+			enum class	Algorithm
+			{
+				/**
+				 * @brief CRC-32C (Castagnoli), using the SSE 4.2 instruction when the CPU supports it.
+				 */
+				CRC32C,
+				/**
+				 * @brief 64 bits xxHash, with a 0 seed.
+				 */
+				XXHASH64,
+				/**
+				 * @brief SHA-256.
+				 */
+				SHA256
+			};
+
+			/**
+			 * @brief A checksum, in big endian byte order.
+			 */
+			typedef std::vector<uint8_t>	Digest;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new Checksum object.
+			 * 
+			 * @param algorithm The algorithm to use.
+			 */
+			explicit Checksum(Algorithm algorithm);
+
+			/**
+			 * @brief Destroy the Checksum object.
+			 */
+			~Checksum(void);
+
+			/**
+			 * @brief Add data to the checksum.
+			 * 
+			 * @param data The data.
+			 * @param size The data size.
+			 */
+			void			update(const char* data, size_t size);
+
+			/**
+			 * @brief Add data to the checksum.
+			 * 
+			 * @param data The data.
+			 */
+			void			update(const Buffer& data);
+
+			/**
+			 * @brief Get the checksum of the data added so far. More data can still be added afterward.
+			 * 
+			 * @return Digest The checksum.
+			 */
+			Digest			digest() const;
+
+			/**
+			 * @brief Get the algorithm used.
+			 * 
+			 * @return Algorithm The algorithm.
+			 */
+			Algorithm		algorithm() const;
+
+			/**
+			 * @brief Format a checksum as an hexadecimal string.
+			 * 
+			 * @param digest The checksum.
+			 * @return std::string The resulting string.
+			 */
+			static std::string	toHex(const Digest& digest);
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			void			updateXxHash64(const uint8_t* data, size_t size);
+			void			updateSha256(const uint8_t* data, size_t size);
+			Digest			digestXxHash64() const;
+			Digest			digestSha256() const;
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			Algorithm		_algorithm;
+			uint32_t		_crc;
+			uint64_t		_state[8];
+			uint8_t			_block[64];
+			size_t			_blockSize;
+			uint64_t		_total;
+
+	};
+}
@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: ChecksumStream.h
+ * Created: 16th October 2026 1:52:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 1:52:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/Checksum.h>
+#include <RxCW/Single.h>
+#include <RxCW/TransformStream.h>
+
+// stl
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class ChecksumStream ChecksumStream.h RxCW/ChecksumStream.h
+	 * @brief Passes the data written to it through unchanged, computing its checksum on the way.
+	 * 
+	 * Placed in the middle of a pipe chain, the data is verified while it is moved instead of being read a second time.
+	 */
+	class	ChecksumStream : public TransformStream
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new ChecksumStream object.
+			 * 
+			 * @param algorithm The checksum algorithm.
+			 */
+			explicit ChecksumStream(Checksum::Algorithm algorithm);
+
+			/**
+			 * @brief Destroy the ChecksumStream object.
+			 */
+			virtual ~ChecksumStream(void);
+
+			/**
+			 * @brief Get the checksum of all the data written to the stream.
+			 * 
+			 * @return Single<Checksum::Digest> A Single emitting the digest once the stream is ended for writing, or failing
+			 * if the stream fails or is destroyed first.
+			 */
+			Single<Checksum::Digest>	rxDigest();
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			virtual void	transform(const Buffer& data);
+			virtual void	flush();
+			virtual void	failed(std::exception_ptr exception);
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			struct	DigestWaiter
+			{
+				Single<Checksum::Digest>::SuccessFunction	onSuccess;
+				Single<Checksum::Digest>::ErrorFunction		onError;
+			};
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			Checksum					_checksum;
+			bool						_done;
+			Checksum::Digest			_digest;
+			std::exception_ptr			_failure;
+			std::vector<DigestWaiter>	_digestWaiters;
+
+	};
+}
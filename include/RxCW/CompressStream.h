@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: CompressStream.h
+ * Created: 16th October 2026 12:58:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:58:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/TransformStream.h>
+
+// stl
+#include <map>
+#include <memory>
+#include <vector>
+
+/*
+****************
+** class used **
+****************
+*/
+
+struct	z_stream_s;
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class CompressStream CompressStream.h RxCW/CompressStream.h
+	 * @brief Compresses the data written to it in the gzip format. Requires the ENABLE_ZLIB build option.
+	 * 
+	 * With a parallelism greater than 1, the data is split in blocks compressed at the same time on the IOScheduler
+	 * compute threads, each block as a separate gzip member. Concatenated members are a valid gzip file, read back by
+	 * any gzip implementation, at the cost of a slightly lower ratio.
+	 */
+	class	CompressStream : public TransformStream
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The default compression level.
+			 */
+			static const int	DEFAULT_LEVEL = 6;
+			/**
+			 * @brief The default size of the blocks compressed in parallel.
+			 */
+			static const size_t	DEFAULT_BLOCK_SIZE = 1024 * 1024;
+			/**
+			 * @brief The size of the chunks the compressed data is written to, when not compressing in parallel.
+			 */
+			static const size_t	OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new CompressStream object.
+			 * 
+			 * @param level The compression level, from 0 (no compression) to 9 (best compression).
+			 * @param parallelism The number of blocks compressed at the same time. 1 compresses on the writing thread, as a single gzip member.
+			 * @param blockSize The size of the blocks compressed in parallel.
+			 */
+			CompressStream(int level = DEFAULT_LEVEL, size_t parallelism = 1, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+			/**
+			 * @brief Destroy the CompressStream object.
+			 */
+			virtual ~CompressStream(void);
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			virtual void	transform(const Buffer& data);
+			virtual void	flush();
+			virtual bool	busy();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			void			compressStream(const Buffer& data, int flush);
+			void			compressBlock();
+			void			blockCompressed(uint64_t index, const Buffer& data);
+			static Buffer	compress(const std::vector<Buffer>& parts, size_t size, int level);
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			int								_level;
+			size_t							_parallelism;
+			size_t							_blockSize;
+			std::unique_ptr<z_stream_s>		_stream;
+
+			std::vector<Buffer>				_block;
+			size_t							_blockFill;
+			uint64_t						_nextBlock;
+			uint64_t						_nextPush;
+			std::map<uint64_t, Buffer>		_compressed;
+			size_t							_pending;
+			bool							_flushing;
+
+	};
+}
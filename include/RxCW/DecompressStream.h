@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: DecompressStream.h
+ * Created: 16th October 2026 12:58:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:58:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/TransformStream.h>
+
+// stl
+#include <memory>
+
+/*
+****************
+** class used **
+****************
+*/
+
+struct	z_stream_s;
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class DecompressStream DecompressStream.h RxCW/DecompressStream.h
+	 * @brief Decompresses the gzip or zlib data written to it. Requires the ENABLE_ZLIB build option.
+	 * 
+	 * Concatenated gzip members, such as the ones written by a parallel CompressStream, are decompressed one after the other.
+	 */
+	class	DecompressStream : public TransformStream
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The size of the chunks the decompressed data is written to.
+			 */
+			static const size_t	OUTPUT_CHUNK_SIZE = 64 * 1024;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new DecompressStream object.
+			 */
+			DecompressStream(void);
+
+			/**
+			 * @brief Destroy the DecompressStream object.
+			 */
+			virtual ~DecompressStream(void);
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			virtual void	transform(const Buffer& data);
+			virtual void	flush();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			std::unique_ptr<z_stream_s>	_stream;
+			bool						_started;
+			bool						_memberEnded;
+
+	};
+}
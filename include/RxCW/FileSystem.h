@@ -38,11 +38,24 @@
 */
 
 // RxCW
+#include <RxCW/Buffer.h>
 #include <RxCW/Completable.h>
+#include <RxCW/Observable.h>
 #include <RxCW/Single.h>
 
+// RxCpp
+#include <rx.hpp>
+
 // stl
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 /*
 ****************
@@ -65,6 +78,9 @@ namespace	RxCW
 	/**
 	 * @class FileSystem FileSystem.h RxCW/FileSystem.h
 	 * @brief Utility class to asynchronously manipulate the file system.
+	 * 
+	 * The rx methods run their blocking calls on the Schedulers given to them, by default the ones set with
+	 * @ref setSchedulers, or else a thread of the IOScheduler blocking calls pool.
 	 */
 	class	FileSystem
 	{
@@ -77,6 +93,219 @@ namespace	RxCW
 
 		public:
 
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief Where the rx methods run their blocking calls, and where they deliver the results.
+			 */
+			struct	Schedulers
+			{
+				/**
+				 * @brief Construct a new Schedulers object, the results being delivered on the io scheduler.
+				 * 
+				 * @param io The scheduler running the blocking calls.
+				 */
+				Schedulers(const rxcpp::schedulers::scheduler& io);
+
+				/**
+				 * @brief Construct a new Schedulers object.
+				 * 
+				 * @param io The scheduler running the blocking calls.
+				 * @param result The scheduler the results are delivered on, such as the caller's event loop.
+				 */
+				Schedulers(const rxcpp::schedulers::scheduler& io, const rxcpp::schedulers::scheduler& result);
+
+				rxcpp::schedulers::scheduler				io;
+				std::optional<rxcpp::schedulers::scheduler>	result;
+			};
+
+			/**
+			 * @brief An entry found while walking a directory.
+			 */
+			struct	DirEntry
+			{
+				/**
+				 * @brief The entry types.
+				 */
+				enum class	Type
+				{
+					FILE,
+					DIRECTORY,
+					SYMLINK,
+					OTHER
+				};
+
+				/**
+				 * @brief The entry path, the walked directory path followed by the path relative to it.
+				 */
+				std::string	path;
+				/**
+				 * @brief The entry name.
+				 */
+				std::string	name;
+				/**
+				 * @brief The entry type. Symbolic links are never followed.
+				 */
+				Type		type;
+				/**
+				 * @brief The entry depth, 1 for the entries of the walked directory itself.
+				 */
+				size_t		depth;
+				/**
+				 * @brief The entry inode number, 0 when not available.
+				 */
+				uint64_t	inode;
+			};
+
+			/**
+			 * @brief Function deciding what to do with a DirEntry while walking a directory.
+			 */
+			typedef std::function<bool(const DirEntry&)>	EntryFilter;
+
+			/**
+			 * @brief Options of @ref rxWalk.
+			 */
+			struct	WalkOptions
+			{
+				/**
+				 * @brief Construct a new WalkOptions object, walking the whole tree and emitting every entry.
+				 */
+				WalkOptions(void);
+
+				/**
+				 * @brief The maximum depth of the emitted entries, 1 only lists the walked directory.
+				 */
+				size_t		maxDepth;
+				/**
+				 * @brief Decides which entries are emitted, all of them if empty. Runs on the walking thread.
+				 */
+				EntryFilter	filter;
+				/**
+				 * @brief Decides which directories are walked into, all of them if empty, whether they are emitted or not.
+				 */
+				EntryFilter	descend;
+				/**
+				 * @brief Skip the directories that can't be read instead of failing.
+				 */
+				bool		ignoreErrors;
+				/**
+				 * @brief The size of the buffer each open directory is read with.
+				 */
+				size_t		bufferSize;
+			};
+
+			/**
+			 * @brief The progress of a recursive operation, as totals since it started.
+			 */
+			struct	Progress
+			{
+				/**
+				 * @brief The number of files, symbolic links included, removed or copied.
+				 */
+				uint64_t	files;
+				/**
+				 * @brief The number of directories removed or copied.
+				 */
+				uint64_t	directories;
+				/**
+				 * @brief The number of bytes copied, always 0 when removing.
+				 */
+				uint64_t	bytes;
+			};
+
+			/**
+			 * @brief The status of a file, symbolic links being followed.
+			 */
+			struct	StatResult
+			{
+				/**
+				 * @brief The file path.
+				 */
+				std::string								path;
+				/**
+				 * @brief Whether the file exists, the other fields are only set when it does.
+				 */
+				bool									exists;
+				/**
+				 * @brief The errno value of the failed stat call, 0 on success.
+				 */
+				int										error;
+				/**
+				 * @brief The file type, never DirEntry::Type::SYMLINK.
+				 */
+				DirEntry::Type							type;
+				/**
+				 * @brief The file size in bytes.
+				 */
+				uint64_t								size;
+				/**
+				 * @brief The file permission bits.
+				 */
+				uint32_t								mode;
+				/**
+				 * @brief The file inode number, 0 when not available.
+				 */
+				uint64_t								inode;
+				/**
+				 * @brief The last modification time of the file.
+				 */
+				std::chrono::system_clock::time_point	modified;
+			};
+
+			/**
+			 * @brief A change reported by @ref rxWatch.
+			 */
+			struct	FsEvent
+			{
+				/**
+				 * @brief The change types, combined in masks.
+				 */
+				enum	Type : uint32_t
+				{
+					CREATED = 1 << 0,
+					MODIFIED = 1 << 1,
+					ATTRIBUTES = 1 << 2,
+					REMOVED = 1 << 3,
+					MOVED_FROM = 1 << 4,
+					MOVED_TO = 1 << 5,
+					/**
+					 * @brief Events were lost, the watched path was rescanned and should be compared to the known state.
+					 */
+					RESCAN = 1 << 6,
+					ALL = (1 << 7) - 1
+				};
+
+				/**
+				 * @brief The changed path.
+				 */
+				std::string	path;
+				/**
+				 * @brief The types of the changes coalesced in this event.
+				 */
+				uint32_t	types;
+				/**
+				 * @brief Whether the changed path is a directory.
+				 */
+				bool		directory;
+			};
+
+			/**
+			 * @brief The default size of the buffers directories are read with.
+			 */
+			static const size_t	DEFAULT_WALK_BUFFER_SIZE = 64 * 1024;
+			/**
+			 * @brief The default maximum number of paths kept in the metadata cache.
+			 */
+			static const size_t	DEFAULT_METADATA_CACHE_SIZE = 4096;
+			/**
+			 * @brief The default time in milliseconds a watched path must stay unchanged before its events are emitted.
+			 */
+			static const unsigned	DEFAULT_WATCH_DEBOUNCE = 50;
+
 			/*
 			*************
 			** methods **
@@ -88,6 +317,50 @@ namespace	RxCW
 			 */
 			virtual ~FileSystem(void);
 
+			/**
+			 * @brief Set the Schedulers used by the rx methods when none is given to them.
+			 * 
+			 * @param schedulers The default Schedulers.
+			 */
+			static void					setSchedulers(const Schedulers& schedulers);
+
+			/**
+			 * @brief Go back to running the rx methods blocking calls on the IOScheduler blocking calls pool.
+			 */
+			static void					resetSchedulers();
+
+			/**
+			 * @brief Get the Schedulers used by the rx methods when none is given to them.
+			 * 
+			 * @return Schedulers The Schedulers set with @ref setSchedulers, or else the next thread of the IOScheduler
+			 * blocking calls pool.
+			 */
+			static Schedulers			schedulers();
+
+			/**
+			 * @brief Cache the status of the paths given to @ref exists and @ref fileSize, and their reactive versions.
+			 * 
+			 * Cached entries are dropped when the paths are changed through FileSystem, but changes made by other means,
+			 * writes to an open AsyncFile included, are only seen once the entries expire. Once the cache is full, the least
+			 * recently used path is dropped. Disabled by default.
+			 * 
+			 * @param ttl How long a status is kept, 0 disables the cache.
+			 * @param maxEntries The maximum number of cached paths.
+			 */
+			static void					setMetadataCache(std::chrono::milliseconds ttl, size_t maxEntries = DEFAULT_METADATA_CACHE_SIZE);
+
+			/**
+			 * @brief Drop the cached status of a path, and of every path below it.
+			 * 
+			 * @param path The path.
+			 */
+			static void					invalidateMetadata(const std::string& path);
+
+			/**
+			 * @brief Drop every cached status.
+			 */
+			static void					clearMetadataCache();
+
 			/**
 			 * @brief Open the given file with the specified modes.
 			 * 
@@ -100,6 +373,10 @@ namespace	RxCW
 			 *  - @b r+: Open a file for read/write, does not create the file if it does not already exists.\n
 			 *  - @b w+: Create a file for read/write, truncate the file if it already exists, create it otherwise.\n
 			 *  - @b a+: Open a file for read/write, writings will be appended to the file. Create the file if it does not already exists.\n
+			 *  - @b rm: Open the file for reading through a memory mapping instead of read calls. Only available for reading, not supported on Windows.\n
+			 *  - @b rd, @b wd, @b r+d, @b w+d: Bypass the page cache (O_DIRECT). Transfers go through aligned buffers, the last partial block is written when the file is ended.
+			 *  Positional writes must be aligned on AsyncFile::DIRECT_IO_ALIGNMENT. Not available in append mode, only supported on Linux.\n
+			 * @throw std::system_error The file can't be opened.
 			 */
 			static AsyncFile*			open(const std::string& path, const std::string& mode);
 
@@ -108,9 +385,10 @@ namespace	RxCW
 			 * 
 			 * @param path The file to open.
 			 * @param mode The mode to open the file with.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Single<AsyncFile*> The resulting Single.
 			 */
-			static Single<AsyncFile*>	rxOpen(const std::string& path, const std::string& mode);
+			static Single<AsyncFile*>	rxOpen(const std::string& path, const std::string& mode, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Check if a file or directory exists
@@ -125,9 +403,10 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref exists method.
 			 * 
 			 * @param path The file to check.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Single<bool> The resulting Single.
 			 */
-			static Single<bool>		rxExists(const std::string& path);
+			static Single<bool>		rxExists(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Remove a file or directory.
@@ -140,9 +419,10 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref remove method.
 			 * 
 			 * @param path The file or directory to remove.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Completable		rxRemove(const std::string& path);
+			static Completable		rxRemove(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Remove a file or directory with all its content.
@@ -155,9 +435,41 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref removeRecursive method.
 			 * 
 			 * @param path The file or directory to remove recursively.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Completable		rxRemoveRecursive(const std::string& path);
+			static Completable		rxRemoveRecursive(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Remove a file or directory with all its content, several directories being handled at the same time.
+			 * 
+			 * Directories are listed and their files removed by tasks run on the IOScheduler blocking calls pool, large
+			 * directories being split in several tasks. Each worker keeps the tasks it adds, and steals from the others once
+			 * it has none left. A directory is removed once all its content is. Entries are reached
+			 * by name from their parent directory descriptor, never by their full path. Unsubscribing stops the operation
+			 * once the running tasks are done. Not supported on Windows, where the tree is removed by a single thread.
+			 * 
+			 * @param path The file or directory to remove recursively.
+			 * @param parallelism The maximum number of tasks running at the same time, also bounded by the pool size.
+			 * @param schedulers Where to start the operation and deliver the progress.
+			 * @return Observable<Progress> An Observable emitting the progress periodically, and once more before completing.
+			 */
+			static Observable<Progress>	rxRemoveRecursive(const std::string& path, size_t parallelism, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Copy a file or directory with all its content, several directories being handled at the same time.
+			 * 
+			 * Works like the parallel @ref rxRemoveRecursive. On Linux, file contents are copied by the kernel with
+			 * copy_file_range when the file systems allow it. Symbolic links are copied as links, and other special files
+			 * are skipped. Existing files are overwritten.
+			 * 
+			 * @param source The file or directory to copy.
+			 * @param destination The copy path.
+			 * @param parallelism The maximum number of tasks running at the same time, also bounded by the pool size.
+			 * @param schedulers Where to start the operation and deliver the progress.
+			 * @return Observable<Progress> An Observable emitting the progress periodically, and once more before completing.
+			 */
+			static Observable<Progress>	rxCopyRecursive(const std::string& source, const std::string& destination, size_t parallelism, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Move/rename a file or a directory.
@@ -172,9 +484,10 @@ namespace	RxCW
 			 * 
 			 * @param oldPath The current path.
 			 * @param newPath The destination path.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Completable		rxMove(const std::string& oldPath, const std::string& newPath);
+			static Completable		rxMove(const std::string& oldPath, const std::string& newPath, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Create a directory.
@@ -187,9 +500,10 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref mkdir method.
 			 * 
 			 * @param path The directory path.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Completable		rxMkdir(const std::string& path);
+			static Completable		rxMkdir(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Create a directory and all its parents if they don't exists.
@@ -202,9 +516,10 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref mkdirs method.
 			 * 
 			 * @param path The directory path.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Completable		rxMkdirs(const std::string& path);
+			static Completable		rxMkdirs(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
 
 			/**
 			 * @brief Get a file size.
@@ -218,9 +533,81 @@ namespace	RxCW
 			 * @brief The reactive version of the @ref fileSize method.
 			 * 
 			 * @param path The file path.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
 			 * @return Completable The resulting Completable.
 			 */
-			static Single<size_t>	rxFileSize(const std::string& path);
+			static Single<size_t>	rxFileSize(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Get the status of many files, emitting one StatResult per path in the given order.
+			 * 
+			 * A missing or unreadable file is reported by its StatResult instead of failing the Observable. On Linux the files
+			 * are stated with statx, and when the library is built with io_uring the requests are submitted by batches with a
+			 * single system call each. The results refresh the metadata cache when it is enabled.
+			 * 
+			 * @param paths The file paths.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
+			 * @return Observable<StatResult> The resulting Observable.
+			 */
+			static Observable<StatResult>	rxStatMany(const std::vector<std::string>& paths, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Read a whole file by chunks, several of them being read at the same time on the IOScheduler threads.
+			 * 
+			 * Chunks are emitted in file order. At most parallelism chunks are read ahead of the last emitted one,
+			 * so a slow subscriber slows the reads down instead of buffering the file. Not supported on Windows.
+			 * 
+			 * @param path The file path.
+			 * @param chunkSize The size of each chunk, the last one may be shorter.
+			 * @param parallelism The maximum number of chunks read or waiting to be emitted at the same time.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
+			 * @return Observable<Buffer> The resulting Observable.
+			 */
+			static Observable<Buffer>	rxReadChunks(const std::string& path, size_t chunkSize, size_t parallelism, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief List the entries of a directory.
+			 * 
+			 * @param path The directory path.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
+			 * @return Observable<DirEntry> The resulting Observable.
+			 * @see rxWalk
+			 */
+			static Observable<DirEntry>	rxList(const std::string& path, const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Walk a directory tree depth first, emitting its entries as they are read.
+			 * 
+			 * On Linux, directories are read with getdents64 into large buffers, and the entry types are known without
+			 * calling stat on most file systems. Entries are emitted on the walking thread as soon as they are read, so only
+			 * one buffer per open directory is held, and a slow subscriber slows the walk down instead of buffering the tree,
+			 * unless the entries are delivered on a Schedulers::result scheduler.
+			 * 
+			 * @param path The directory path.
+			 * @param options The walk options.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
+			 * @return Observable<DirEntry> The resulting Observable.
+			 */
+			static Observable<DirEntry>	rxWalk(const std::string& path, const WalkOptions& options = WalkOptions(), const Schedulers& schedulers = FileSystem::schedulers());
+
+			/**
+			 * @brief Watch a file or a directory for changes, until unsubscribed from or until the path is removed or moved.
+			 * 
+			 * The changes of a path are coalesced into a single FsEvent, emitted once the path stayed unchanged for the
+			 * debounce time, or at the latest after ten times that time under constant changes. When the kernel event queue
+			 * overflows, recursive watches are rescanned to watch the directories created in the meantime, and a
+			 * FsEvent::RESCAN event is emitted for the watched path. Every watch shares a single inotify instance and thread,
+			 * the events are emitted on it unless a Schedulers::result scheduler is given. The emitted paths are dropped from
+			 * the metadata cache. Only supported on Linux.
+			 * 
+			 * @param path The watched path.
+			 * @param events The FsEvent::Type mask of the changes to emit.
+			 * @param recursive Also watch the subdirectories, including the ones created later.
+			 * @param debounce How long a path must stay unchanged before its events are emitted, 0 emits them right away.
+			 * @param schedulers Where to run the blocking calls and deliver the result.
+			 * @return Observable<FsEvent> The resulting Observable.
+			 */
+			static Observable<FsEvent>	rxWatch(const std::string& path, uint32_t events = FsEvent::ALL, bool recursive = false, std::chrono::milliseconds debounce = std::chrono::milliseconds(DEFAULT_WATCH_DEBOUNCE), const Schedulers& schedulers = FileSystem::schedulers());
 
 		/*
 		************************************************************************
@@ -230,6 +617,19 @@ namespace	RxCW
 
 		private:
 
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			struct	CachedStat
+			{
+				StatResult								result;
+				std::chrono::steady_clock::time_point	expiry;
+				std::list<std::string>::iterator		recent;
+			};
+
 			/*
 			*************
 			** methods **
@@ -241,5 +641,28 @@ namespace	RxCW
 			 */
 			FileSystem(void);
 
+			static std::optional<StatResult>	cachedStat(const std::string& path);
+			static uint64_t						metadataGeneration();
+			static void							cacheStat(const StatResult& result, uint64_t generation);
+			static std::map<std::string, CachedStat>::iterator	dropStat(std::map<std::string, CachedStat>::iterator it);
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			static std::mutex					_mutex;
+			static std::optional<Schedulers>	_schedulers;
+
+			static std::mutex							_metadataMutex;
+			static std::chrono::milliseconds			_metadataTtl;
+			static size_t								_metadataCacheSize;
+			static std::map<std::string, CachedStat>	_metadata;
+			// the cached paths, most recently used first
+			static std::list<std::string>				_recent;
+			// changed by every invalidation, a status stated before it is not cached
+			static uint64_t								_metadataGeneration;
+
 	};
 }
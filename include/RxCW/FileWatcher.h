@@ -0,0 +1,257 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: FileWatcher.h
+ * Created: 16th October 2026 4:12:37 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 4:12:37 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/FileSystem.h>
+
+// stl
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+****************
+** class used **
+****************
+*/
+
+struct	inotify_event;
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class FileWatcher FileWatcher.h RxCW/FileWatcher.h
+	 * @brief Linux inotify engine used by FileSystem to watch files and directories.
+	 * 
+	 * A single inotify instance and thread serve every watch, directories watched by several watches being watched once.
+	 * Only available on Linux.
+	 */
+	class	FileWatcher
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief Function called with the coalesced events of a watch.
+			 */
+			typedef std::function<void(FileSystem::FsEvent)>	EventFunction;
+
+			/**
+			 * @brief Function called when a watch fails.
+			 */
+			typedef std::function<void(std::exception_ptr)>		ErrorFunction;
+
+			/**
+			 * @brief Function called when the watched path is removed or moved.
+			 */
+			typedef std::function<void()>						CompleteFunction;
+
+			/**
+			 * @brief The size of the buffer events are read with.
+			 */
+			static const size_t		EVENT_BUFFER_SIZE = 64 * 1024;
+
+			/**
+			 * @brief How many debounce times the events of a path that keeps changing can be delayed.
+			 */
+			static const unsigned	MAX_DEBOUNCE_FACTOR = 10;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Destroy the FileWatcher object, waiting for its thread to stop.
+			 */
+			virtual ~FileWatcher(void);
+
+			/**
+			 * @brief Get the shared watcher, starting it on first use.
+			 * 
+			 * @return FileWatcher* The watcher.
+			 * @throw std::system_error If inotify is not available.
+			 */
+			static FileWatcher*	get();
+
+			/**
+			 * @brief Start watching a path, see FileSystem::rxWatch.
+			 * 
+			 * @param path The watched path.
+			 * @param events The FileSystem::FsEvent::Type mask of the changes to report.
+			 * @param recursive Also watch the subdirectories, including the ones created later.
+			 * @param debounce How long a path must stay unchanged before its events are reported.
+			 * @param onEvent The function called with the events, on the watcher thread.
+			 * @param onError The function called if the watch fails.
+			 * @param onComplete The function called when the watched path is removed or moved.
+			 * @return uint64_t The watch identifier, to give to @ref unwatch.
+			 * @throw std::system_error If the path can't be watched.
+			 */
+			uint64_t			watch(const std::string& path, uint32_t events, bool recursive, std::chrono::milliseconds debounce, const EventFunction& onEvent, const ErrorFunction& onError, const CompleteFunction& onComplete);
+
+			/**
+			 * @brief Stop a watch, no function of it is called once this returns, unless from another thread already calling it.
+			 * 
+			 * @param id The watch identifier.
+			 */
+			void				unwatch(uint64_t id);
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			struct	Pending
+			{
+				FileSystem::FsEvent						event;
+				std::chrono::steady_clock::time_point	first;
+				std::chrono::steady_clock::time_point	last;
+			};
+
+			struct	Watch
+			{
+				uint64_t							id;
+				std::string							path;
+				int									root;
+				bool								directory;
+				uint32_t							events;
+				bool								recursive;
+				std::chrono::milliseconds			debounce;
+				EventFunction						onEvent;
+				ErrorFunction						onError;
+				CompleteFunction					onComplete;
+				std::atomic<bool>					active;
+				bool								ended;
+				std::exception_ptr					error;
+				std::set<int>						directories;
+				std::map<std::string, Pending>		pending;
+			};
+
+			struct	WatchedDirectory
+			{
+				std::string			path;
+				std::set<Watch*>	watches;
+			};
+
+			struct	Delivery
+			{
+				std::shared_ptr<Watch>				watch;
+				std::vector<FileSystem::FsEvent>	events;
+				bool								complete;
+				std::exception_ptr					error;
+			};
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new FileWatcher object.
+			 */
+			FileWatcher(void);
+
+			void	run();
+			void	handle(const inotify_event* event, std::chrono::steady_clock::time_point now);
+			void	rescan(std::chrono::steady_clock::time_point now);
+			void	addDirectory(Watch* watch, const std::string& path, bool scan, std::chrono::steady_clock::time_point now);
+			void	removeDirectories(const std::set<Watch*>& watches, const std::string& path);
+			void	detach(Watch* watch);
+			void	report(Watch* watch, const std::string& path, uint32_t types, bool directory, std::chrono::steady_clock::time_point now);
+			std::chrono::steady_clock::time_point	flush(std::chrono::steady_clock::time_point now, std::vector<Delivery>& deliveries);
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			static std::mutex					_instanceMutex;
+			static std::unique_ptr<FileWatcher>	_instance;
+
+			int										_fd;
+			int										_wakeFd;
+			std::mutex								_mutex;
+			std::thread								_thread;
+			bool									_stopped;
+			uint64_t								_nextId;
+			std::map<uint64_t, std::shared_ptr<Watch>>	_watches;
+			std::map<int, WatchedDirectory>			_directories;
+			std::map<std::string, int>				_paths;
+
+	};
+}
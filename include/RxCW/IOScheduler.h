@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: IOScheduler.h
+ * Created: 16th October 2026 10:12:31 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 10:12:31 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCpp
+#include <rx.hpp>
+
+// stl
+#include <mutex>
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class IOScheduler IOScheduler.h RxCW/IOScheduler.h
+	 * @brief Bounded pool of threads shared by every AsyncFile to run its I/O operations.
+	 * 
+	 * Each call to @ref scheduler returns a scheduler bound to a single thread of the pool, picked in a round robin way.
+	 * Everything scheduled through it runs sequentially, so a file keeping the same scheduler has its operations serialized.
+	 * A second pool, returned by @ref blockingScheduler, runs the blocking calls such as the FileSystem metadata
+	 * operations, so that a slow one does not hold the file operations queued behind it. A third one, returned by
+	 * @ref computeScheduler, runs the CPU bound work such as compression, which would delay the I/O otherwise.
+	 */
+	class	IOScheduler
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The default number of threads in the pool.
+			 */
+			static const size_t	DEFAULT_THREAD_COUNT = 4;
+
+			/**
+			 * @brief The default number of threads in the blocking calls pool.
+			 */
+			static const size_t	DEFAULT_BLOCKING_THREAD_COUNT = 4;
+
+			/**
+			 * @brief The default number of threads in the CPU bound work pool.
+			 */
+			static const size_t	DEFAULT_COMPUTE_THREAD_COUNT = 4;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Destroy the IOScheduler object.
+			 */
+			virtual ~IOScheduler(void);
+
+			/**
+			 * @brief Set the number of threads in the pool. Must be called before the pool is first used.
+			 * 
+			 * @param count The number of threads.
+			 */
+			static void							setThreadCount(size_t count);
+
+			/**
+			 * @brief Get the number of threads in the pool.
+			 * 
+			 * @return size_t The number of threads.
+			 */
+			static size_t						threadCount();
+
+			/**
+			 * @brief Get a scheduler running everything on the next thread of the pool.
+			 * 
+			 * @return rxcpp::schedulers::scheduler The resulting scheduler.
+			 */
+			static rxcpp::schedulers::scheduler	scheduler();
+
+			/**
+			 * @brief Set the number of threads in the blocking calls pool. Must be called before the pool is first used.
+			 * 
+			 * @param count The number of threads.
+			 */
+			static void							setBlockingThreadCount(size_t count);
+
+			/**
+			 * @brief Get the number of threads in the blocking calls pool.
+			 * 
+			 * @return size_t The number of threads.
+			 */
+			static size_t						blockingThreadCount();
+
+			/**
+			 * @brief Get a scheduler running everything on the next thread of the blocking calls pool.
+			 * 
+			 * @return rxcpp::schedulers::scheduler The resulting scheduler.
+			 */
+			static rxcpp::schedulers::scheduler	blockingScheduler();
+
+			/**
+			 * @brief Set the number of threads in the CPU bound work pool. Must be called before the pool is first used.
+			 * 
+			 * @param count The number of threads.
+			 */
+			static void							setComputeThreadCount(size_t count);
+
+			/**
+			 * @brief Get the number of threads in the CPU bound work pool.
+			 * 
+			 * @return size_t The number of threads.
+			 */
+			static size_t						computeThreadCount();
+
+			/**
+			 * @brief Get a scheduler running everything on the next thread of the CPU bound work pool.
+			 * 
+			 * @return rxcpp::schedulers::scheduler The resulting scheduler.
+			 */
+			static rxcpp::schedulers::scheduler	computeScheduler();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new IOScheduler object.
+			 */
+			IOScheduler(void);
+
+			static rxcpp::schedulers::scheduler	next(std::vector<rxcpp::schedulers::worker>& workers, size_t count, size_t& index);
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			static std::mutex							_mutex;
+			static size_t								_threadCount;
+			static std::vector<rxcpp::schedulers::worker>	_workers;
+			static size_t								_next;
+			static size_t								_blockingThreadCount;
+			static std::vector<rxcpp::schedulers::worker>	_blockingWorkers;
+			static size_t								_nextBlocking;
+			static size_t								_computeThreadCount;
+			static std::vector<rxcpp::schedulers::worker>	_computeWorkers;
+			static size_t								_nextCompute;
+
+	};
+}
@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: IOUring.h
+ * Created: 16th October 2026 11:02:17 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:02:17 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// linux
+#include <sys/types.h>
+#include <sys/uio.h>
+
+/*
+****************
+** class used **
+****************
+*/
+
+struct	io_uring_sqe;
+struct	io_uring_cqe;
+struct	statx;
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class IOUring IOUring.h RxCW/IOUring.h
+	 * @brief Linux io_uring engine used by AsyncFile to read and write files, and by FileSystem to stat them, without blocking a thread per file.
+	 * 
+	 * There is one ring per IOScheduler thread, each ring has its own completion thread calling the completion functions.
+	 * Requests prepared by different threads between two submissions are submitted together. Requests the kernel refuses
+	 * are taken back and completed at once with the error, on the thread submitting them.
+	 * Only available when the library is built with the ENABLE_IO_URING cmake option.
+	 */
+	class	IOUring
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief Function called when a request completes. Takes the number of bytes transferred, or a negative errno value on failure.
+			 */
+			typedef std::function<void(ssize_t)>	CompletionFunction;
+
+			/**
+			 * @brief A statx request, see @ref stat.
+			 */
+			struct	StatRequest
+			{
+				/**
+				 * @brief The directory relative paths are resolved from, AT_FDCWD for the current directory.
+				 */
+				int					dirfd;
+				/**
+				 * @brief The path, must stay valid until completion.
+				 */
+				const char*			path;
+				/**
+				 * @brief The statx flags, such as AT_SYMLINK_NOFOLLOW.
+				 */
+				int					flags;
+				/**
+				 * @brief The statx mask of the requested fields.
+				 */
+				unsigned int		mask;
+				/**
+				 * @brief Where to store the result, must stay valid until completion.
+				 */
+				struct ::statx*		buffer;
+				/**
+				 * @brief The function to call on completion, with 0 on success.
+				 */
+				CompletionFunction	onComplete;
+			};
+
+			/**
+			 * @brief The number of submission queue entries of each ring.
+			 */
+			static const unsigned	DEFAULT_QUEUE_DEPTH = 256;
+
+			/**
+			 * @brief Offset to use to read or write at the current file position, like read/write would do.
+			 */
+			static const uint64_t	CURRENT_POSITION = UINT64_MAX;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Destroy the IOUring object, waiting for the completion thread to stop.
+			 */
+			virtual ~IOUring(void);
+
+			/**
+			 * @brief Get the next ring of the pool.
+			 * 
+			 * @return IOUring* The ring, or nullptr if io_uring is not available on this system.
+			 */
+			static IOUring*	get();
+
+			/**
+			 * @brief Asynchronously read from a file descriptor.
+			 * 
+			 * @param fd The file descriptor.
+			 * @param data Where to store the data read, must stay valid until completion.
+			 * @param size The number of bytes to read.
+			 * @param offset The offset to read from, or @ref CURRENT_POSITION.
+			 * @param onComplete The function to call on completion.
+			 */
+			void			read(int fd, void* data, size_t size, uint64_t offset, const CompletionFunction& onComplete);
+
+			/**
+			 * @brief Asynchronously write to a file descriptor.
+			 * 
+			 * @param fd The file descriptor.
+			 * @param data The data to write, must stay valid until completion.
+			 * @param size The number of bytes to write.
+			 * @param offset The offset to write at, or @ref CURRENT_POSITION.
+			 * @param onComplete The function to call on completion.
+			 */
+			void			write(int fd, const void* data, size_t size, uint64_t offset, const CompletionFunction& onComplete);
+
+			/**
+			 * @brief Asynchronously write several buffers to a file descriptor at once.
+			 * 
+			 * @param fd The file descriptor.
+			 * @param vector The buffers to write, the array and the buffers must stay valid until completion.
+			 * @param count The number of buffers.
+			 * @param offset The offset to write at, or @ref CURRENT_POSITION.
+			 * @param onComplete The function to call on completion.
+			 */
+			void			writev(int fd, const iovec* vector, size_t count, uint64_t offset, const CompletionFunction& onComplete);
+
+			/**
+			 * @brief Asynchronously get the status of several files with statx, all of the requests being submitted at once.
+			 * 
+			 * @param requests The requests.
+			 */
+			void			stat(const std::vector<StatRequest>& requests);
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new IOUring object.
+			 * 
+			 * @param entries The number of submission queue entries.
+			 */
+			IOUring(unsigned entries);
+
+			void	prepare(std::unique_lock<std::mutex>& lock, uint8_t opcode, int fd, const void* data, size_t size, uint64_t offset, CompletionFunction* onComplete, uint32_t flags = 0);
+			void	submit(std::unique_lock<std::mutex>& lock);
+			void	fail(std::unique_lock<std::mutex>& lock, int error);
+			void	run();
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			static std::mutex							_poolMutex;
+			static bool									_poolInitialized;
+			static std::vector<std::unique_ptr<IOUring>>	_pool;
+			static size_t								_next;
+
+			int				_fd;
+			std::mutex		_mutex;
+			unsigned		_pending;
+			std::thread		_thread;
+
+			void*			_sqRing;
+			size_t			_sqRingSize;
+			void*			_cqRing;
+			size_t			_cqRingSize;
+			io_uring_sqe*	_sqes;
+			size_t			_sqesSize;
+
+			unsigned*		_sqHead;
+			unsigned*		_sqTail;
+			unsigned		_sqMask;
+			unsigned		_sqEntries;
+			unsigned*		_sqArray;
+
+			unsigned*		_cqHead;
+			unsigned*		_cqTail;
+			unsigned		_cqMask;
+			io_uring_cqe*	_cqes;
+
+	};
+}
@@ -110,6 +110,26 @@ namespace	RxCW
 			 */
 			typedef std::function<void(SuccessFunction, CompleteFunction, ErrorFunction)>	Handler;
 
+			/**
+			 * @brief Function releasing what a CancellableHandler acquired.
+			 */
+			typedef std::function<void()>													CancelFunction;
+
+			/**
+			 * @brief Function that can be used to construct a new Observable, like a Handler, returning the function to call once the Observable is unsubscribed from.
+			 */
+			typedef std::function<CancelFunction(SuccessFunction, CompleteFunction, ErrorFunction)>	CancellableHandler;
+
+			/**
+			 * @brief Function telling if the Observable is still subscribed to.
+			 */
+			typedef std::function<bool()>													SubscribedFunction;
+
+			/**
+			 * @brief Function that can be used to construct a new Observable, like a Handler, also taking a function telling if the Observable is still subscribed to.
+			 */
+			typedef std::function<void(SuccessFunction, CompleteFunction, ErrorFunction, SubscribedFunction)>	InterruptibleHandler;
+
 			/*
 			*************
 			** methods **
@@ -129,6 +149,26 @@ namespace	RxCW
 			 */
 			static Observable<T>	create(const Handler& handler);
 
+			/**
+			 * @brief Create a new Observable using the given handler, for sources that keep emitting until they are unsubscribed from.
+			 * 
+			 * The returned CancelFunction is called once, when the subscriber unsubscribes or after the Observable terminates.
+			 * 
+			 * @param handler The handler.
+			 * @return Observable The resulting Observable.
+			 */
+			static Observable<T>	createCancellable(const CancellableHandler& handler);
+
+			/**
+			 * @brief Create a new Observable using the given handler, for sources emitting from the handler itself.
+			 * 
+			 * The handler checks the SubscribedFunction while it runs, and returns early once it returns false.
+			 * 
+			 * @param handler The handler.
+			 * @return Observable The resulting Observable.
+			 */
+			static Observable<T>	createInterruptible(const InterruptibleHandler& handler);
+
 			/**
 			 * @brief Defer Observable creation to the given function.
 			 * 
@@ -86,6 +86,62 @@ RxCW::Observable<T>	RxCW::Observable<T>::create(const Handler& handler)
 	));
 }
 
+template	<typename T>
+RxCW::Observable<T>	RxCW::Observable<T>::createCancellable(const CancellableHandler& handler)
+{
+	return Observable<T>(rxcpp::observable<>::create<T>(
+		[handler](rxcpp::subscriber<T> subscriber)
+	{
+		CancelFunction	cancel = handler(
+			[subscriber](T value)
+		{
+			subscriber.on_next(value);
+		},
+			[subscriber]()
+		{
+			subscriber.on_completed();
+		},
+			[subscriber](std::exception_ptr error)
+		{
+			subscriber.on_error(error);
+		}
+		);
+
+		// called right away if the subscriber already unsubscribed
+		if (cancel)
+			subscriber.add(cancel);
+	}
+	));
+}
+
+template	<typename T>
+RxCW::Observable<T>	RxCW::Observable<T>::createInterruptible(const InterruptibleHandler& handler)
+{
+	return Observable<T>(rxcpp::observable<>::create<T>(
+		[handler](rxcpp::subscriber<T> subscriber)
+	{
+		handler(
+			[subscriber](T value)
+		{
+			subscriber.on_next(value);
+		},
+			[subscriber]()
+		{
+			subscriber.on_completed();
+		},
+			[subscriber](std::exception_ptr error)
+		{
+			subscriber.on_error(error);
+		},
+			[subscriber]()
+		{
+			return subscriber.is_subscribed();
+		}
+		);
+	}
+	));
+}
+
 template	<typename T>
 RxCW::Observable<T>	RxCW::Observable<T>::defer(const std::function<RxCW::Observable<T>()>& function)
 {
@@ -0,0 +1,311 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Pipe.h
+ * Created: 16th October 2026 3:04:51 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 3:04:51 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/IOScheduler.h>
+#include <RxCW/ReadStream.h>
+#include <RxCW/RingBuffer.h>
+#include <RxCW/WriteStream.h>
+
+// RxCpp
+#include <rx.hpp>
+
+// stl
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class Pipe Pipe.h RxCW/Pipe.h
+	 * @brief A connected WriteStream and ReadStream pair, the data written to one being read from the other.
+	 * 
+	 * The values go through a bounded lock-free queue without being copied, and are delivered to the reader on a
+	 * single worker of the given scheduler. The writer must not be used from several threads at the same time.
+	 * The Pipe must outlive both streams usage.
+	 * 
+	 * @tparam T The type of the values, can be move-only. Such values must be written with WriteStream::write(T&&),
+	 * and read with Reader::moveHandler.
+	 */
+	template	<typename T>
+	class	Pipe
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The default number of values the writer can queue before its write queue is full.
+			 */
+			static const size_t	DEFAULT_CAPACITY = 64;
+
+			/**
+			 * @brief Function that will be called with each value read, taking its ownership.
+			 */
+			typedef std::function<void(T&&)>	MoveFunction;
+
+			/**
+			 * @class Reader Pipe.h RxCW/Pipe.h
+			 * @brief The reading end of a Pipe.
+			 */
+			class	Reader : public ReadStream<T>
+			{
+				public:
+
+					/**
+					 * @brief Set the handler to call when a value handler throws. Nothing is read afterward.
+					 * 
+					 * @param handler The handler.
+					 */
+					virtual void	exceptionHandler(const typename StreamBase<T>::ErrorFunction& handler);
+
+					/**
+					 * @brief Set the handler to call once the writer is ended and all the values are read.
+					 * 
+					 * @param handler The handler.
+					 */
+					virtual void	endHandler(const typename ReadStream<T>::EndFunction& handler);
+
+					/**
+					 * @brief Set the handler to call for each value read. Replaces the handler set with @ref moveHandler.
+					 * 
+					 * @param handler The handler.
+					 */
+					virtual void	handler(const typename ReadStream<T>::DataFunction& handler);
+
+					/**
+					 * @brief Pause the stream. A value being delivered is still delivered.
+					 */
+					virtual void	pause();
+
+					/**
+					 * @brief Resume the stream. The reader starts paused.
+					 */
+					virtual void	resume();
+
+					/**
+					 * @brief Set the handler to call for each value read, moving the value to it. Replaces the handler set
+					 * with @ref handler.
+					 * 
+					 * @param handler The handler.
+					 */
+					void			moveHandler(const MoveFunction& handler);
+
+				private:
+
+					friend class	Pipe;
+
+					explicit Reader(Pipe& pipe);
+
+					Pipe&	_pipe;
+			};
+
+			/**
+			 * @class Writer Pipe.h RxCW/Pipe.h
+			 * @brief The writing end of a Pipe.
+			 */
+			class	Writer : public WriteStream<T>
+			{
+				public:
+
+					/**
+					 * @brief Set the exception handler. The writer never fails by itself.
+					 * 
+					 * @param handler The handler.
+					 */
+					virtual void	exceptionHandler(const typename StreamBase<T>::ErrorFunction& handler);
+
+					/**
+					 * @brief Set the handler to call on the reader worker when values can be written again.
+					 * 
+					 * @param handler The handler.
+					 */
+					virtual void	drainHandler(const typename WriteStream<T>::DrainFunction& handler);
+
+					/**
+					 * @brief End writing. The reader ends once the queued values are read.
+					 */
+					virtual void	end();
+
+					/**
+					 * @brief Write a copy of the given value.
+					 * 
+					 * @param data The value.
+					 * @throw std::logic_error The stream is ended, or T is move-only.
+					 * @throw std::overflow_error The queue holds twice its max size, the writer ignored @ref writeQueueFull.
+					 */
+					virtual void	write(const T& data);
+
+					/**
+					 * @brief Write the given value, moving it to the queue.
+					 * 
+					 * @param data The value.
+					 * @throw std::logic_error The stream is ended.
+					 * @throw std::overflow_error The queue holds twice its max size, the writer ignored @ref writeQueueFull.
+					 */
+					virtual void	write(T&& data);
+
+					/**
+					 * @brief Set the number of queued values from which the write queue is full.
+					 * 
+					 * @param size The write queue max size, at most the Pipe capacity.
+					 * @throw std::invalid_argument The size is 0 or greater than the Pipe capacity.
+					 */
+					virtual void	setWriteQueueMaxSize(size_t size);
+
+					/**
+					 * @brief Checks if the write queue is full. The drain handler is called once it is not anymore.
+					 * 
+					 * @return \b true: no more values should be written for now.
+					 * @return \b false: values can be written.
+					 */
+					virtual bool	writeQueueFull();
+
+				private:
+
+					friend class	Pipe;
+
+					explicit Writer(Pipe& pipe);
+
+					Pipe&	_pipe;
+			};
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new Pipe object.
+			 * 
+			 * @param capacity The number of values the writer can queue before its write queue is full.
+			 * @param scheduler The scheduler the values are delivered to the reader on.
+			 */
+			explicit Pipe(size_t capacity = DEFAULT_CAPACITY, const rxcpp::schedulers::scheduler& scheduler = IOScheduler::scheduler());
+
+			/**
+			 * @brief Destroy the Pipe object.
+			 */
+			~Pipe(void);
+
+			/**
+			 * @brief Get the writing end of the pipe.
+			 * 
+			 * @return Writer& The WriteStream.
+			 */
+			Writer&		writeStream();
+
+			/**
+			 * @brief Get the reading end of the pipe.
+			 * 
+			 * @return Reader& The ReadStream.
+			 */
+			Reader&		readStream();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			void		schedule();
+			void		deliver();
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			size_t				_capacity;
+			// twice the capacity, to absorb the values written while the source is being paused
+			RingBuffer<T>		_queue;
+			std::atomic<size_t>	_writeQueueSize;
+			std::atomic<bool>	_full;
+			std::atomic<bool>	_writeEnded;
+			std::atomic<bool>	_paused;
+			std::atomic<bool>	_scheduled;
+			bool				_ended;
+
+			std::mutex								_handlersMutex;
+			typename StreamBase<T>::ErrorFunction	_readErrorHandler;
+			typename StreamBase<T>::ErrorFunction	_writeErrorHandler;
+			typename ReadStream<T>::DataFunction	_dataHandler;
+			MoveFunction							_moveHandler;
+			typename ReadStream<T>::EndFunction		_endHandler;
+			typename WriteStream<T>::DrainFunction	_drainHandler;
+
+			rxcpp::schedulers::scheduler	_scheduler;
+			rxcpp::composite_subscription	_lifetime;
+			rxcpp::schedulers::worker		_worker;
+
+			Reader				_reader;
+			Writer				_writer;
+
+	};
+}
+
+#include <RxCW/Pipe.inl>
@@ -0,0 +1,292 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Pipe.inl
+ * Created: 16th October 2026 3:04:51 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 3:04:51 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <stdexcept>
+#include <type_traits>
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+template	<typename T>
+RxCW::Pipe<T>::Pipe(size_t capacity, const rxcpp::schedulers::scheduler& scheduler)
+	: _capacity(capacity)
+	, _queue(capacity * 2)
+	, _writeQueueSize(capacity)
+	, _full(false)
+	, _writeEnded(false)
+	, _paused(true)
+	, _scheduled(false)
+	, _ended(false)
+	, _scheduler(scheduler)
+	, _worker(_scheduler.create_worker(_lifetime))
+	, _reader(*this)
+	, _writer(*this)
+{
+}
+
+template	<typename T>
+RxCW::Pipe<T>::~Pipe(void)
+{
+	_lifetime.unsubscribe();
+}
+
+template	<typename T>
+typename RxCW::Pipe<T>::Writer&	RxCW::Pipe<T>::writeStream()
+{
+	return _writer;
+}
+
+template	<typename T>
+typename RxCW::Pipe<T>::Reader&	RxCW::Pipe<T>::readStream()
+{
+	return _reader;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::schedule()
+{
+	if (_scheduled.exchange(true))
+		return ;
+	_worker.schedule([this](const rxcpp::schedulers::schedulable&)
+	{
+		deliver();
+	});
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::deliver()
+{
+	typename ReadStream<T>::DataFunction	dataHandler;
+	MoveFunction							moveHandler;
+
+	// cleared first, so that a value pushed from now on schedules another delivery
+	_scheduled = false;
+	if (_ended)
+		return ;
+	{
+		std::lock_guard<std::mutex>	lock(_handlersMutex);
+
+		dataHandler = _dataHandler;
+		moveHandler = _moveHandler;
+	}
+
+	T*	value;
+
+	while (!_paused && (value = _queue.front()))
+	{
+		try
+		{
+			if (moveHandler)
+				moveHandler(std::move(*value));
+			else if (dataHandler)
+				dataHandler(*value);
+		}
+		catch (const std::exception&)
+		{
+			std::exception_ptr						exception = std::current_exception();
+			typename StreamBase<T>::ErrorFunction	errorHandler;
+
+			_ended = true;
+			{
+				std::lock_guard<std::mutex>	lock(_handlersMutex);
+
+				errorHandler = _readErrorHandler;
+			}
+			if (errorHandler)
+				errorHandler(exception);
+			return ;
+		}
+		_queue.pop();
+
+		// pairs with the fence in writeQueueFull, one of both sides sees the other one
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (_queue.size() < _writeQueueSize && _full.exchange(false))
+		{
+			typename WriteStream<T>::DrainFunction	drainHandler;
+
+			{
+				std::lock_guard<std::mutex>	lock(_handlersMutex);
+
+				drainHandler = _drainHandler;
+			}
+			if (drainHandler)
+				drainHandler();
+		}
+	}
+
+	// the end flag is checked first, every value pushed before it was set is then visible
+	if (!_paused && _writeEnded && _queue.empty())
+	{
+		typename ReadStream<T>::EndFunction	endHandler;
+
+		_ended = true;
+		{
+			std::lock_guard<std::mutex>	lock(_handlersMutex);
+
+			endHandler = _endHandler;
+		}
+		if (endHandler)
+			endHandler();
+	}
+}
+
+template	<typename T>
+RxCW::Pipe<T>::Reader::Reader(Pipe& pipe)
+	: _pipe(pipe)
+{
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::exceptionHandler(const typename StreamBase<T>::ErrorFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._readErrorHandler = handler;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::endHandler(const typename ReadStream<T>::EndFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._endHandler = handler;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::handler(const typename ReadStream<T>::DataFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._dataHandler = handler;
+	_pipe._moveHandler = MoveFunction();
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::moveHandler(const MoveFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._moveHandler = handler;
+	_pipe._dataHandler = typename ReadStream<T>::DataFunction();
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::pause()
+{
+	_pipe._paused = true;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Reader::resume()
+{
+	_pipe._paused = false;
+	_pipe.schedule();
+}
+
+template	<typename T>
+RxCW::Pipe<T>::Writer::Writer(Pipe& pipe)
+	: _pipe(pipe)
+{
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::exceptionHandler(const typename StreamBase<T>::ErrorFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._writeErrorHandler = handler;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::drainHandler(const typename WriteStream<T>::DrainFunction& handler)
+{
+	std::lock_guard<std::mutex>	lock(_pipe._handlersMutex);
+
+	_pipe._drainHandler = handler;
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::end()
+{
+	if (_pipe._writeEnded.exchange(true))
+		return ;
+	_pipe.schedule();
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::write(const T& data)
+{
+	if constexpr (std::is_copy_constructible<T>::value)
+		write(T(data));
+	else
+		throw std::logic_error("can't copy a move-only value, it must be moved to the pipe");
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::write(T&& data)
+{
+	if (_pipe._writeEnded)
+		throw std::logic_error("can't write to an ended stream");
+	if (!_pipe._queue.push(std::move(data)))
+		throw std::overflow_error("the pipe is full, writeQueueFull was ignored");
+	_pipe.schedule();
+}
+
+template	<typename T>
+void		RxCW::Pipe<T>::Writer::setWriteQueueMaxSize(size_t size)
+{
+	if (!size || size > _pipe._capacity)
+		throw std::invalid_argument("size must be between 1 and the pipe capacity");
+	_pipe._writeQueueSize = size;
+}
+
+template	<typename T>
+bool		RxCW::Pipe<T>::Writer::writeQueueFull()
+{
+	if (_pipe._queue.size() < _pipe._writeQueueSize)
+		return false;
+	_pipe._full = true;
+	// the reader may have emptied the queue meanwhile without seeing the flag, in which case nobody would drain it
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_pipe._queue.size() < _pipe._writeQueueSize && _pipe._full.exchange(false))
+		return false;
+	return true;
+}
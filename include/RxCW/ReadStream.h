@@ -43,6 +43,7 @@
 
 // stl
 #include <functional>
+#include <vector>
 
 /*
 ****************
@@ -101,6 +102,55 @@ namespace	RxCW
 			 */
 			typedef std::function<void(const T&)>	DataFunction;
 
+			/**
+			 * @brief What to do with a destination of a fan-out pipe whose write queue is full.
+			 */
+			enum class	Backpressure
+			{
+				/**
+				 * @brief Pause the source until the destination drains.
+				 */
+				PAUSE,
+				/**
+				 * @brief Discard the data for this destination until it drains, the source keeps flowing.
+				 */
+				DROP,
+				/**
+				 * @brief Queue the data in memory for this destination until it drains. The source is paused only once
+				 * the spill queue holds its max size.
+				 */
+				SPILL
+			};
+
+			/**
+			 * @brief The default number of chunks a SPILL destination can hold before pausing the source.
+			 */
+			static const size_t	DEFAULT_SPILL_SIZE = 64;
+
+			/**
+			 * @brief A destination of a fan-out pipe, with its backpressure policy.
+			 */
+			struct	PipeTarget
+			{
+				/**
+				 * @brief Construct a new PipeTarget object.
+				 * 
+				 * @param stream The destination stream.
+				 * @param policy What to do when the destination write queue is full.
+				 * @param spillSize The max number of chunks queued in memory with the SPILL policy.
+				 */
+				PipeTarget(WriteStream<T>& stream, Backpressure policy = Backpressure::PAUSE, size_t spillSize = DEFAULT_SPILL_SIZE)
+					: stream(&stream)
+					, policy(policy)
+					, spillSize(spillSize)
+				{
+				}
+
+				WriteStream<T>*	stream;
+				Backpressure	policy;
+				size_t			spillSize;
+			};
+
 			/*
 			*************
 			** methods **
@@ -144,6 +194,18 @@ namespace	RxCW
 			 */
 			virtual Completable	rxPipeTo(WriteStream<T>& writeStream);
 
+			/**
+			 * @brief Asynchronously pipe this stream to several WriteStreams, each of them receiving all the data.
+			 * 
+			 * The source is paused only while a PAUSE destination, or a SPILL destination with a full spill queue, can't
+			 * keep up. The pipe completes once every destination is ended, and fails with the first error of the source or
+			 * of a destination. Handlers can be called from any thread.
+			 * 
+			 * @param destinations The destinations, such as {file, {queue, Backpressure::DROP}}.
+			 * @return The resulting Completable.
+			 */
+			virtual Completable	rxPipeTo(const std::vector<PipeTarget>& destinations);
+
 		/*
 		************************************************************************
 		******************************* PROTECTED ******************************
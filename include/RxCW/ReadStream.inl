@@ -35,6 +35,14 @@
 **************
 */
 
+// stl
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
 /*
 ********************************************************************************
 ************************************ METHODS ***********************************
@@ -66,10 +74,10 @@ RxCW::Completable	RxCW::ReadStream<T>::rxPipeTo(WriteStream<T>& writeStream)
 			if (writeStream.writeQueueFull())
 				this->pause();
 		});
-		this->endHandler([&writeStream, onComplete]()
+		this->endHandler([&writeStream, onComplete, onError]()
 		{
-			writeStream.end();
-			onComplete();
+			// the pipe completes once the stream is done writing
+			writeStream.rxEnd().subscribe(onComplete, onError);
 		});
 		this->exceptionHandler([onError](std::exception_ptr exception)
 		{
@@ -82,3 +90,213 @@ RxCW::Completable	RxCW::ReadStream<T>::rxPipeTo(WriteStream<T>& writeStream)
 		this->resume();
 	});
 }
+
+template	<typename T>
+RxCW::Completable	RxCW::ReadStream<T>::rxPipeTo(const std::vector<PipeTarget>& destinations)
+{
+	struct	Lane
+	{
+		PipeTarget		target;
+		std::deque<T>	spill;
+		bool			full;
+		bool			ending;
+	};
+
+	struct	Fanout
+	{
+		std::recursive_mutex	mutex;
+		std::atomic<bool>		drainPending;
+		bool					busy;
+		bool					paused;
+		bool					ended;
+		bool					terminated;
+		size_t					remaining;
+		std::deque<Lane>		lanes;
+	};
+
+	return Completable::create([this, destinations](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
+	{
+		std::shared_ptr<Fanout>	fanout = std::make_shared<Fanout>();
+
+		fanout->drainPending = false;
+		fanout->busy = false;
+		fanout->paused = false;
+		fanout->ended = false;
+		fanout->terminated = false;
+		fanout->remaining = destinations.size();
+		for (const PipeTarget& target : destinations)
+			fanout->lanes.push_back({ target, std::deque<T>(), false, false });
+
+		std::function<bool()>	pausing = [fanout]()
+		{
+			for (const Lane& lane : fanout->lanes)
+			{
+				if ((lane.target.policy == Backpressure::PAUSE && lane.full) ||
+					(lane.target.policy == Backpressure::SPILL && lane.spill.size() >= lane.target.spillSize))
+					return true;
+			}
+			return false;
+		};
+		std::function<void(std::exception_ptr)>	fail = [fanout, onError](std::exception_ptr exception)
+		{
+			{
+				std::lock_guard<std::recursive_mutex>	lock(fanout->mutex);
+
+				if (fanout->terminated)
+					return ;
+				fanout->terminated = true;
+			}
+			onError(exception);
+		};
+		// called with the lock held. Destinations draining while another thread owns the lock only raise drainPending,
+		// so the owner handles them before releasing the lock, then checks again once it is released
+		std::shared_ptr<std::function<void(std::unique_lock<std::recursive_mutex>&)>>	settle = std::make_shared<std::function<void(std::unique_lock<std::recursive_mutex>&)>>();
+
+		*settle = [this, fanout, pausing, fail, onComplete, weakSettle = std::weak_ptr<std::function<void(std::unique_lock<std::recursive_mutex>&)>>(settle)](std::unique_lock<std::recursive_mutex>& lock)
+		{
+			do
+			{
+				std::vector<WriteStream<T>*>	ending;
+				std::exception_ptr				exception;
+				bool							resume = false;
+
+				fanout->busy = true;
+				while (fanout->drainPending.exchange(false) && !fanout->terminated)
+				{
+					try
+					{
+						for (Lane& lane : fanout->lanes)
+						{
+							while (!lane.spill.empty() && !lane.target.stream->writeQueueFull())
+							{
+								lane.target.stream->write(std::move(lane.spill.front()));
+								lane.spill.pop_front();
+							}
+							lane.full = lane.target.stream->writeQueueFull();
+						}
+					}
+					catch (const std::exception&)
+					{
+						exception = std::current_exception();
+						break;
+					}
+				}
+				if (!fanout->terminated && !exception)
+				{
+					if (fanout->paused && !fanout->ended && !pausing())
+					{
+						fanout->paused = false;
+						resume = true;
+					}
+					// a SPILL destination ends once its spill queue is written
+					for (Lane& lane : fanout->lanes)
+					{
+						if (fanout->ended && !lane.ending && lane.spill.empty())
+						{
+							lane.ending = true;
+							ending.push_back(lane.target.stream);
+						}
+					}
+				}
+				fanout->busy = false;
+				lock.unlock();
+
+				if (exception)
+					fail(exception);
+				if (resume)
+					this->resume();
+				for (WriteStream<T>* stream : ending)
+				{
+					stream->rxEnd().subscribe([fanout, onComplete, weakSettle]()
+					{
+						std::unique_lock<std::recursive_mutex>	lock(fanout->mutex);
+
+						if (--fanout->remaining || fanout->terminated)
+						{
+							if (std::shared_ptr<std::function<void(std::unique_lock<std::recursive_mutex>&)>> settle = weakSettle.lock())
+								(*settle)(lock);
+							return ;
+						}
+						fanout->terminated = true;
+						lock.unlock();
+						onComplete();
+					}, fail);
+				}
+			}
+			while (fanout->drainPending && lock.try_lock());
+		};
+
+		for (Lane& lane : fanout->lanes)
+		{
+			lane.target.stream->drainHandler([fanout, settle]()
+			{
+				std::unique_lock<std::recursive_mutex>	lock(fanout->mutex, std::defer_lock);
+
+				fanout->drainPending = true;
+				// the owner of the lock, possibly this very thread writing to the destination, handles the drain
+				if (lock.try_lock() && !fanout->busy)
+					(*settle)(lock);
+			});
+			lane.target.stream->exceptionHandler(fail);
+		}
+		this->handler([this, fanout, settle, pausing, fail](const T& data)
+		{
+			std::unique_lock<std::recursive_mutex>	lock(fanout->mutex);
+
+			if (fanout->terminated)
+				return ;
+			fanout->busy = true;
+			try
+			{
+				for (Lane& lane : fanout->lanes)
+				{
+					// keep the order of the spilled data, and skip the lagging destinations
+					if (!lane.spill.empty() || (lane.full && lane.target.policy != Backpressure::PAUSE))
+					{
+						if (lane.target.policy == Backpressure::SPILL)
+						{
+							// the spill queue keeps its own copy
+							if constexpr (std::is_copy_constructible<T>::value)
+								lane.spill.push_back(data);
+							else
+								throw std::logic_error("can't spill a move-only value");
+						}
+						continue;
+					}
+					lane.target.stream->write(data);
+					lane.full = lane.target.stream->writeQueueFull();
+				}
+			}
+			catch (const std::exception&)
+			{
+				fanout->busy = false;
+				lock.unlock();
+				fail(std::current_exception());
+				return ;
+			}
+			// only paused from the source thread, resumed by the drains
+			if (pausing())
+			{
+				fanout->paused = true;
+				this->pause();
+			}
+			(*settle)(lock);
+		});
+		this->endHandler([fanout, settle, onComplete]()
+		{
+			std::unique_lock<std::recursive_mutex>	lock(fanout->mutex);
+
+			fanout->ended = true;
+			if (fanout->lanes.empty() && !fanout->terminated)
+			{
+				fanout->terminated = true;
+				lock.unlock();
+				onComplete();
+				return ;
+			}
+			(*settle)(lock);
+		});
+		this->exceptionHandler(fail);
+		this->resume();
+	});
+}
@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: RecordReadStream.h
+ * Created: 16th October 2026 11:48:27 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:48:27 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/Buffer.h>
+#include <RxCW/ReadStream.h>
+#include <RxCW/WriteStream.h>
+
+// stl
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class RecordReadStream RecordReadStream.h RxCW/RecordReadStream.h
+	 * @brief Splits the chunks of another ReadStream into records, either delimited by a byte or prefixed by their length.
+	 * 
+	 * A record held by a single chunk is emitted as a slice of it, without copying it. Only records spanning several chunks
+	 * are copied, once, when they are complete. The source handlers are taken over by this stream, which must outlive it.
+	 */
+	class	RecordReadStream : public ReadStream<Buffer>
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The default maximum record size.
+			 */
+			static const size_t	DEFAULT_MAX_RECORD_SIZE = 1024 * 1024;
+
+			/**
+			 * @brief How the length of the records is encoded, before each record.
+			 */
+			struct	LengthPrefix
+			{
+				/**
+				 * @brief The size of the length, in bytes, between 1 and 8.
+				 */
+				size_t	size = 4;
+				/**
+				 * @brief The byte order of the length.
+				 */
+				bool	bigEndian = true;
+			};
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new RecordReadStream splitting records on the given delimiter, which is not part of the records.
+			 * 
+			 * The data after the last delimiter is emitted as a last record when the source ends.
+			 * 
+			 * @param source The stream to read the chunks from.
+			 * @param delimiter The delimiter.
+			 * @param maxRecordSize The maximum record size, the stream fails with a std::length_error on bigger records.
+			 */
+			RecordReadStream(ReadStream<Buffer>& source, char delimiter, size_t maxRecordSize = DEFAULT_MAX_RECORD_SIZE);
+
+			/**
+			 * @brief Construct a new RecordReadStream reading records prefixed by their length, which is not part of the records.
+			 * 
+			 * @param source The stream to read the chunks from.
+			 * @param lengthPrefix The encoding of the length.
+			 * @param maxRecordSize The maximum record size, the stream fails with a std::length_error on bigger records.
+			 */
+			RecordReadStream(ReadStream<Buffer>& source, const LengthPrefix& lengthPrefix, size_t maxRecordSize = DEFAULT_MAX_RECORD_SIZE);
+
+			/**
+			 * @brief Destroy the RecordReadStream object.
+			 */
+			virtual ~RecordReadStream(void);
+
+			/**
+			 * @brief Set the handler to call when an exception occurs.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void	exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler);
+
+			/**
+			 * @brief Set the handler to call once the last record is emitted.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void	endHandler(const ReadStream<Buffer>::EndFunction& handler);
+
+			/**
+			 * @brief Set the handler to call for each record.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void	handler(const ReadStream<Buffer>::DataFunction& handler);
+
+			/**
+			 * @brief Pause the stream, no record is emitted until it is resumed.
+			 */
+			virtual void	pause();
+
+			/**
+			 * @brief Resume the stream.
+			 */
+			virtual void	resume();
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Called for each complete record, calls the data handler.
+			 * 
+			 * @param record The record.
+			 */
+			virtual void	emit(const Buffer& record);
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			void	listen();
+			void	process();
+			size_t	frameDelimited(const Buffer& chunk);
+			size_t	frameLength(const Buffer& chunk);
+			void	append(const Buffer& data);
+			Buffer	take(const Buffer& last);
+			void	fail(std::exception_ptr exception);
+			void	finish();
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			ReadStream<Buffer>&	_source;
+			bool				_lengthPrefixed;
+			char				_delimiter;
+			LengthPrefix		_lengthPrefix;
+			size_t				_maxRecordSize;
+
+			std::recursive_mutex	_mutex;
+			std::atomic<bool>		_paused;
+			bool					_sourceEnded;
+			bool					_ended;
+			std::deque<Buffer>		_backlog;
+			std::vector<Buffer>		_parts;
+			size_t					_partsSize;
+			unsigned char			_header[8];
+			size_t					_headerSize;
+			size_t					_recordSize;
+
+			StreamBase<Buffer>::ErrorFunction	_errorHandler;
+			ReadStream<Buffer>::EndFunction		_endHandler;
+			ReadStream<Buffer>::DataFunction	_dataHandler;
+
+	};
+}
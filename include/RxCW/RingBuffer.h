@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: RingBuffer.h
+ * Created: 16th October 2026 4:18:50 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 4:18:50 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <atomic>
+#include <memory>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class RingBuffer RingBuffer.h RxCW/RingBuffer.h
+	 * @brief A bounded lock-free queue for one producer thread and one consumer thread.
+	 * 
+	 * @ref push must only be called by the producer, @ref front and @ref pop only by the consumer.
+	 * 
+	 * @tparam T The type of the queued values, must be default constructible and movable.
+	 */
+	template	<typename T>
+	class	RingBuffer
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new RingBuffer object.
+			 * 
+			 * @param capacity The minimum number of values the RingBuffer can hold, rounded up to a power of two.
+			 */
+			explicit RingBuffer(size_t capacity);
+
+			/**
+			 * @brief Destroy the RingBuffer object.
+			 */
+			~RingBuffer(void);
+
+			/**
+			 * @brief Push a value at the end of the queue.
+			 * 
+			 * @param value The value to push.
+			 * @return \b true: the value was pushed.
+			 * @return \b false: the queue is full, the value was not pushed.
+			 */
+			bool	push(T&& value);
+
+			/**
+			 * @brief Get the value at the front of the queue, without removing it.
+			 * 
+			 * The consumer may modify the value in place, the producer never accesses it until it is popped.
+			 * 
+			 * @return T* The value, or nullptr if the queue is empty.
+			 */
+			T*		front();
+
+			/**
+			 * @brief Get the value at the given position in the queue, without removing it.
+			 * 
+			 * @param index The position, 0 being the front of the queue.
+			 * @return T* The value, or nullptr if the queue holds less values.
+			 */
+			T*		peek(size_t index);
+
+			/**
+			 * @brief Remove the value at the front of the queue.
+			 * 
+			 * @param value Where to move the removed value.
+			 * @return \b true: a value was removed.
+			 * @return \b false: the queue is empty.
+			 */
+			bool	pop(T& value);
+
+			/**
+			 * @brief Remove the value at the front of the queue.
+			 * 
+			 * @return \b true: a value was removed.
+			 * @return \b false: the queue is empty.
+			 */
+			bool	pop();
+
+			/**
+			 * @brief Get the number of values in the queue. Can be called from any thread.
+			 * 
+			 * @return size_t The number of values.
+			 */
+			size_t	size() const;
+
+			/**
+			 * @brief Checks if the queue is empty. Can be called from any thread.
+			 * 
+			 * @return \b true: the queue is empty.
+			 * @return \b false: the queue is not empty.
+			 */
+			bool	empty() const;
+
+			/**
+			 * @brief Get the number of values the queue can hold.
+			 * 
+			 * @return size_t The capacity.
+			 */
+			size_t	capacity() const;
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			size_t					_capacity;
+			size_t					_mask;
+			std::unique_ptr<T[]>	_values;
+
+			// producer and consumer indexes live on different cache lines
+			alignas(64) std::atomic<size_t>	_head;
+			alignas(64) std::atomic<size_t>	_tail;
+
+	};
+}
+
+#include <RxCW/RingBuffer.inl>
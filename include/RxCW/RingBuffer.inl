@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: RingBuffer.inl
+ * Created: 16th October 2026 4:19:02 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 4:19:02 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <stdexcept>
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+template	<typename T>
+RxCW::RingBuffer<T>::RingBuffer(size_t capacity)
+	: _capacity(1)
+	, _head(0)
+	, _tail(0)
+{
+	if (!capacity)
+		throw std::invalid_argument("capacity must be greater than 0");
+
+	while (_capacity < capacity)
+		_capacity <<= 1;
+	_mask = _capacity - 1;
+	_values.reset(new T[_capacity]);
+}
+
+template	<typename T>
+RxCW::RingBuffer<T>::~RingBuffer(void)
+{
+}
+
+template	<typename T>
+bool	RxCW::RingBuffer<T>::push(T&& value)
+{
+	size_t	tail = _tail.load(std::memory_order_relaxed);
+
+	if (tail - _head.load(std::memory_order_acquire) == _capacity)
+		return false;
+
+	_values[tail & _mask] = std::move(value);
+	_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template	<typename T>
+T*		RxCW::RingBuffer<T>::front()
+{
+	size_t	head = _head.load(std::memory_order_relaxed);
+
+	if (head == _tail.load(std::memory_order_acquire))
+		return nullptr;
+
+	return &_values[head & _mask];
+}
+
+template	<typename T>
+T*		RxCW::RingBuffer<T>::peek(size_t index)
+{
+	size_t	head = _head.load(std::memory_order_relaxed);
+
+	if (index >= _tail.load(std::memory_order_acquire) - head)
+		return nullptr;
+
+	return &_values[(head + index) & _mask];
+}
+
+template	<typename T>
+bool	RxCW::RingBuffer<T>::pop(T& value)
+{
+	size_t	head = _head.load(std::memory_order_relaxed);
+
+	if (head == _tail.load(std::memory_order_acquire))
+		return false;
+
+	value = std::move(_values[head & _mask]);
+	// release what the slot still holds before handing it back to the producer
+	_values[head & _mask] = T();
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template	<typename T>
+bool	RxCW::RingBuffer<T>::pop()
+{
+	T	value;
+
+	return pop(value);
+}
+
+template	<typename T>
+size_t	RxCW::RingBuffer<T>::size() const
+{
+	// head is loaded first so it can't be ahead of the loaded tail
+	size_t	head = _head.load(std::memory_order_acquire);
+
+	return _tail.load(std::memory_order_acquire) - head;
+}
+
+template	<typename T>
+bool	RxCW::RingBuffer<T>::empty() const
+{
+	return !size();
+}
+
+template	<typename T>
+size_t	RxCW::RingBuffer<T>::capacity() const
+{
+	return _capacity;
+}
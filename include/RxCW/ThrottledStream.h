@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: ThrottledStream.h
+ * Created: 16th October 2026 2:31:08 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 2:31:08 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/TransformStream.h>
+
+// RxCpp
+#include <rx.hpp>
+
+// stl
+#include <chrono>
+#include <deque>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class ThrottledStream ThrottledStream.h RxCW/ThrottledStream.h
+	 * @brief Passes the data written to it through unchanged, capping its throughput with a token bucket.
+	 * 
+	 * The buckets hold at most one second worth of tokens, so an idle stream can burst up to its rates. A chunk waiting
+	 * for tokens reports the write queue as full, so a pipe writing to the stream pauses its source instead of sleeping,
+	 * and resumes it through the drain handler once the chunk is released. A chunk larger than the byte bucket goes
+	 * through once the bucket is full, the following ones waiting for the debt to be paid back.
+	 */
+	class	ThrottledStream : public TransformStream
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new ThrottledStream object.
+			 * 
+			 * @param bytesPerSecond The maximum number of bytes per second, 0 for no limit.
+			 * @param operationsPerSecond The maximum number of chunks per second, 0 for no limit.
+			 */
+			ThrottledStream(size_t bytesPerSecond, size_t operationsPerSecond = 0);
+
+			/**
+			 * @brief Destroy the ThrottledStream object.
+			 */
+			virtual ~ThrottledStream(void);
+
+			/**
+			 * @brief Change the rates. The waiting chunks are released according to the new rates.
+			 * 
+			 * @param bytesPerSecond The maximum number of bytes per second, 0 for no limit.
+			 * @param operationsPerSecond The maximum number of chunks per second, 0 for no limit.
+			 */
+			void			setRates(size_t bytesPerSecond, size_t operationsPerSecond = 0);
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			virtual void	transform(const Buffer& data);
+			virtual void	flush();
+			virtual bool	busy();
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			void			refill();
+			void			release();
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			size_t									_bytesPerSecond;
+			size_t									_operationsPerSecond;
+			double									_byteTokens;
+			double									_operationTokens;
+			std::chrono::steady_clock::time_point	_refilled;
+			std::deque<Buffer>						_waiting;
+			bool									_timerScheduled;
+			bool									_flushing;
+
+			rxcpp::composite_subscription			_lifetime;
+			rxcpp::schedulers::worker				_worker;
+
+	};
+}
@@ -0,0 +1,362 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: TransformStream.h
+ * Created: 16th October 2026 12:31:09 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:31:09 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#pragma once
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include <RxCW/Buffer.h>
+#include <RxCW/ReadStream.h>
+#include <RxCW/WriteStream.h>
+
+// stl
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+**********************
+** class definition **
+**********************
+*/
+
+namespace	RxCW
+{
+	/**
+	 * @class TransformStream TransformStream.h RxCW/TransformStream.h
+	 * @brief Base class for streams transforming the data written to them into the data read from them.
+	 * 
+	 * Such streams can sit in the middle of a pipe chain. Subclasses implement @ref transform, and call @ref push for each
+	 * resulting chunk. Pushed chunks wait in the output queue while the stream is paused, and the write queue is full once
+	 * the output queue reaches its max size. Methods can be called from any thread.
+	 * 
+	 * Handlers are never called with the stream lock held, so that a handler can write to another stream, or to this one.
+	 * @ref push, @ref finish, @ref fail and @ref drained only queue their events, delivered once the lock is released.
+	 * Subclasses calling them outside of @ref transform and @ref flush must call @ref deliver afterwards.
+	 */
+	class	TransformStream : public ReadStream<Buffer>, public WriteStream<Buffer>
+	{
+
+		/*
+		************************************************************************
+		******************************** PUBLIC ********************************
+		************************************************************************
+		*/
+
+		public:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief The default output queue max size.
+			 */
+			static const size_t	DEFAULT_WRITE_QUEUE_SIZE = 16;
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Destroy the TransformStream object.
+			 */
+			virtual ~TransformStream(void);
+
+			/**
+			 * @brief Set the handler to call when an exception occurs.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void		exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler);
+
+			/**
+			 * @brief Set the handler to call once the stream is ended and all its output is read.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void		endHandler(const ReadStream<Buffer>::EndFunction& handler);
+
+			/**
+			 * @brief Set the handler to call for each transformed chunk.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void		handler(const ReadStream<Buffer>::DataFunction& handler);
+
+			/**
+			 * @brief Pause the stream for reading.
+			 */
+			virtual void		pause();
+
+			/**
+			 * @brief Resume the stream for reading.
+			 */
+			virtual void		resume();
+
+			/**
+			 * @brief Set the handler to call when data can be written again.
+			 * 
+			 * @param handler The handler.
+			 */
+			virtual void		drainHandler(const WriteStream<Buffer>::DrainFunction& handler);
+
+			/**
+			 * @brief End writing. The stream ends once the last transformed chunks are read.
+			 */
+			virtual void		end();
+
+			/**
+			 * @brief Write the given data to the stream.
+			 * 
+			 * @param data The data to transform.
+			 * @throw std::logic_error The stream is ended.
+			 */
+			virtual void		write(const Buffer& data);
+
+			/**
+			 * @brief Set the output queue max size.
+			 * 
+			 * @param size The output queue max size.
+			 */
+			virtual void		setWriteQueueMaxSize(size_t size);
+
+			/**
+			 * @brief Checks if the output queue is full.
+			 * 
+			 * @return \b true: no more data should be written to the stream for now.
+			 * @return \b false: data can be written to the stream.
+			 */
+			virtual bool		writeQueueFull();
+
+		/*
+		************************************************************************
+		******************************* PROTECTED ******************************
+		************************************************************************
+		*/
+
+		protected:
+
+			/*
+			***********
+			** types **
+			***********
+			*/
+
+			/**
+			 * @brief Shared with the asynchronous work of a subclass, so that it calls back into the stream only while the
+			 * stream exists. The callback holds a @ref Pin while it uses the stream.
+			 */
+			struct	Token
+			{
+				std::mutex						mutex;
+				std::condition_variable			unpinned;
+				std::atomic<bool>				alive{true};
+				// a thread destroying the stream from its own callback doesn't wait for itself
+				std::vector<std::thread::id>	pins;
+			};
+
+			/**
+			 * @class Pin TransformStream.h RxCW/TransformStream.h
+			 * @brief Keeps the stream from being destroyed by another thread while a callback uses it, without holding any
+			 * lock, so that the handlers it calls may destroy the stream.
+			 */
+			class	Pin
+			{
+				public:
+
+					/**
+					 * @brief Pin the stream of the given token, if it is still alive.
+					 * 
+					 * @param token The token.
+					 */
+					explicit Pin(const std::shared_ptr<Token>& token);
+
+					/**
+					 * @brief Unpin the stream.
+					 */
+					~Pin(void);
+
+					/**
+					 * @brief Checks if the stream is pinned.
+					 * 
+					 * @return \b true: the stream is alive, the callback can use it.
+					 * @return \b false: the stream is destroyed, the callback must return.
+					 */
+					explicit operator bool() const;
+
+				private:
+
+					std::shared_ptr<Token>	_token;
+					bool					_pinned;
+			};
+
+			/*
+			*************
+			** methods **
+			*************
+			*/
+
+			/**
+			 * @brief Construct a new TransformStream object.
+			 */
+			TransformStream(void);
+
+			/**
+			 * @brief Transform the given data, calling @ref push for the results. Called with the stream lock held.
+			 * 
+			 * @param data The data to transform.
+			 */
+			virtual void		transform(const Buffer& data) = 0;
+
+			/**
+			 * @brief Called once the stream is ended, with the stream lock held. Must push the remaining data, then call
+			 * @ref finish, possibly later. The default implementation calls @ref finish right away.
+			 */
+			virtual void		flush();
+
+			/**
+			 * @brief Queue a transformed chunk.
+			 * 
+			 * @param data The chunk.
+			 */
+			void				push(const Buffer& data);
+
+			/**
+			 * @brief Mark the output as complete, the stream ends once the output queue is read.
+			 */
+			void				finish();
+
+			/**
+			 * @brief Make the stream fail with the given exception, dropping the queued chunks.
+			 * 
+			 * @param exception The exception.
+			 */
+			void				fail(std::exception_ptr exception);
+
+			/**
+			 * @brief Called once the stream fails, with the stream lock held. The default implementation does nothing.
+			 * 
+			 * @param exception The exception.
+			 */
+			virtual void		failed(std::exception_ptr exception);
+
+			/**
+			 * @brief Queue a call made by @ref deliver once the lock is released, before the queued chunks.
+			 * 
+			 * @param call The call.
+			 */
+			void				defer(const std::function<void()>& call);
+
+			/**
+			 * @brief Checks if the write queue must be reported as full, in addition to the output queue. Called with the
+			 * stream lock held. The default implementation returns false.
+			 * 
+			 * @return \b true: the subclass can't accept more data for now.
+			 */
+			virtual bool		busy();
+
+			/**
+			 * @brief Queue a call to the drain handler if the write queue was full and is not anymore. Called with the stream
+			 * lock held.
+			 */
+			void				drained();
+
+			/**
+			 * @brief Call the handlers for the queued events. Must be called without the stream lock held.
+			 * 
+			 * A single thread calls the handlers at a time, the events queued meanwhile by other threads are left to it.
+			 * A handler may destroy the stream, nothing is delivered afterwards.
+			 */
+			void				deliver();
+
+			/**
+			 * @brief Mark the token as not alive, waiting for the callbacks pinning the stream from other threads to return.
+			 * Subclasses giving the token to asynchronous work call it first in their destructor.
+			 */
+			void				revoke();
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			std::recursive_mutex	_mutex;
+			std::shared_ptr<Token>	_token;
+
+		/*
+		************************************************************************
+		******************************** PRIVATE *******************************
+		************************************************************************
+		*/
+
+		private:
+
+			/*
+			****************
+			** attributes **
+			****************
+			*/
+
+			bool				_paused;
+			bool				_writeEnded;
+			bool				_finished;
+			bool				_ended;
+			bool				_full;
+			bool				_drainPending;
+			bool				_delivering;
+			std::exception_ptr	_failure;
+			std::deque<std::function<void()>>	_deferred;
+			size_t				_writeQueueSize;
+			std::deque<Buffer>	_output;
+
+			StreamBase<Buffer>::ErrorFunction	_errorHandler;
+			ReadStream<Buffer>::EndFunction		_endHandler;
+			ReadStream<Buffer>::DataFunction	_dataHandler;
+			WriteStream<Buffer>::DrainFunction	_drainHandler;
+
+	};
+}
@@ -122,15 +122,28 @@ namespace	RxCW
 			/**
 			 * @brief Write the given data to the stream.
 			 * 
+			 * Writers must stop writing while @ref writeQueueFull returns true, and wait for the drain handler. Streams may
+			 * bound their queue beyond its max size, Pipe for instance holds up to twice its max size and then throws.
+			 * 
 			 * @param data The data to write to the stream.
+			 * @throw std::overflow_error The stream queue is bounded and the writer ignored @ref writeQueueFull.
 			 */
 			virtual void			write(const T& data) = 0;
 
+			/**
+			 * @brief Write the given data to the stream, moving it instead of copying it when the stream supports it.
+			 * 
+			 * @param data The data to write to the stream.
+			 * @throw std::overflow_error The stream queue is bounded and the writer ignored @ref writeQueueFull.
+			 */
+			virtual void			write(T&& data);
+
 			/**
 			 * @brief Reactive version of the @ref write method.
 			 * 
 			 * @param data The data to write to the stream.
-			 * @return The resulting Completable.
+			 * @return The resulting Completable, failing with std::logic_error if T is move-only, such values must be
+			 * written with write(T&&).
 			 */
 			virtual Completable		rxWrite(const T& data);
 
@@ -35,6 +35,10 @@
 **************
 */
 
+// stl
+#include <stdexcept>
+#include <type_traits>
+
 /*
 ********************************************************************************
 ************************************ METHODS ***********************************
@@ -69,20 +73,30 @@ RxCW::Completable	RxCW::WriteStream<T>::rxEnd()
 	});
 }
 
+template	<typename T>
+void					RxCW::WriteStream<T>::write(T&& data)
+{
+	write(static_cast<const T&>(data));
+}
+
 template	<typename T>
 RxCW::Completable		RxCW::WriteStream<T>::rxWrite(const T& data)
 {
-	return Completable::create([this, data](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
-	{
-		try
+	// the Completable handler must be copyable, and so must be the captured value
+	if constexpr (!std::is_copy_constructible<T>::value)
+		return Completable::error(std::make_exception_ptr(std::logic_error("can't copy a move-only value, it must be written with write(T&&)")));
+	else
+		return Completable::create([this, data](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
 		{
-			this->write(data);
-		}
-		catch (const std::exception& e)
-		{
-			onError(std::make_exception_ptr(e));
-			return;
-		}
-		onComplete();
-	});
+			try
+			{
+				this->write(data);
+			}
+			catch (const std::exception& e)
+			{
+				onError(std::make_exception_ptr(e));
+				return;
+			}
+			onComplete();
+		});
 }
@@ -9,20 +9,24 @@ allowedBuildTypes = ["Release", "Debug"]
 
 # print usage
 def printUsage():
-	print("cmake.py [-h] [--help] [-d] [--dynamic] [-s] [--static] [-b <Debug|Release>] [--buildType <Debug|Release>]")
+	print("cmake.py [-h] [--help] [-d] [--dynamic] [-s] [--static] [-u] [--ioUring] [-z] [--zlib] [-b <Debug|Release>] [--buildType <Debug|Release>]")
 	print("  -h or --help: dysplay help and quit")
 	print("  -d or --dynamic: enable dynamic linking (default)")
 	print("  -s or --static: disable dynamic linking")
+	print("  -u or --ioUring: enable the io_uring AsyncFile backend (linux only)")
+	print("  -z or --zlib: enable the gzip CompressStream and DecompressStream (requires zlib)")
 	print("  -b or --buildType: set build type ('Release' or 'Debug')")
 
 if __name__ == '__main__':
 
 	# define default variables
 	dynamicLinking = True
+	ioUring = False
+	zlib = False
 	buildType = "Release"
 
 	# retrieve arguments
-	opts, args = getopt.getopt(sys.argv[1:], "hdsb:", ["help", "dynamic", "static", "buildType="])
+	opts, args = getopt.getopt(sys.argv[1:], "hdsuzb:", ["help", "dynamic", "static", "ioUring", "zlib", "buildType="])
 
 	# ensure all arguments are parsed
 	if len(args) != 0:
@@ -40,6 +44,10 @@ if __name__ == '__main__':
 			dynamicLinking = True
 		elif opt in ("-s", "--static"):
 			dynamicLinking = False
+		elif opt in ("-u", "--ioUring"):
+			ioUring = True
+		elif opt in ("-z", "--zlib"):
+			zlib = True
 		# build type
 		if opt in ("-b", "--buildType"):
 			if not arg in allowedBuildTypes:
@@ -50,7 +58,7 @@ if __name__ == '__main__':
 
 	# run cmake command
 	print("starting cmake")
-	result = os.system("cmake %s -DENABLE_DYNAMIC_LINK=%s -DCMAKE_TOOLCHAIN_FILE=%s/scripts/buildsystems/vcpkg.cmake -DCMAKE_BUILD_TYPE=%s -B %s" % (rootDir, str(dynamicLinking), vcpkgPath, buildType, buildDir))
+	result = os.system("cmake %s -DENABLE_DYNAMIC_LINK=%s -DENABLE_IO_URING=%s -DENABLE_ZLIB=%s -DCMAKE_TOOLCHAIN_FILE=%s/scripts/buildsystems/vcpkg.cmake -DCMAKE_BUILD_TYPE=%s -B %s" % (rootDir, str(dynamicLinking), str(ioUring), str(zlib), vcpkgPath, buildType, buildDir))
 	if result:
 		print("Cmake KO!")
 	else:
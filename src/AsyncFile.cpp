@@ -37,6 +37,36 @@
 **************
 */
 
+// RxCW
+#include "RxCW/BufferPool.h"
+#include "RxCW/IOScheduler.h"
+#if defined(RXCW_ENABLE_IO_URING)
+#include "RxCW/IOUring.h"
+#endif
+
+// stl
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+// posix
+#if !defined(_WIN32)
+#include <climits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// windows
+#if defined(_WIN32)
+#include <io.h>
+#endif
+
 /*
 ****************
 ** namespaces **
@@ -45,6 +75,26 @@
 
 using namespace RxCW;
 
+/*
+************
+** static **
+************
+*/
+
+#if defined(IOV_MAX)
+static const size_t	WRITE_VECTOR_MAX_SIZE = IOV_MAX;
+#else
+static const size_t	WRITE_VECTOR_MAX_SIZE = 1024;
+#endif
+
+// the kernel copy gives the thread back to the other files between steps
+static const size_t	KERNEL_COPY_STEP_SIZE = 16 * 1024 * 1024;
+
+static size_t		alignDirect(size_t size)
+{
+	return (size + AsyncFile::DIRECT_IO_ALIGNMENT - 1) / AsyncFile::DIRECT_IO_ALIGNMENT * AsyncFile::DIRECT_IO_ALIGNMENT;
+}
+
 /*
 ********************************************************************************
 ************************************ METHODS ***********************************
@@ -53,60 +103,152 @@ using namespace RxCW;
 
 AsyncFile::AsyncFile(void)
 	: _closed(false)
+	, _scheduler(IOScheduler::scheduler())
+	, _worker(_scheduler.create_worker(_lifetime))
+	, _strand(rxcpp::schedulers::make_same_worker(_worker))
+	, _ring(nullptr)
+	, _mapped(false)
+	, _mappingSize(0)
+	, _mappingOffset(0)
+	, _mappingAdvisedEnd(0)
+	, _direct(false)
+	, _directOffset(0)
+	, _directBuffered(0)
 	, _readBufferSize(DEFAULT_READ_BUFFER_SIZE)
+	, _minReadBufferSize(DEFAULT_READ_BUFFER_SIZE)
+	, _maxReadBufferSize(DEFAULT_READ_BUFFER_SIZE)
+	, _readStreak(0)
 	, _paused(true)
 	, _readEnded(false)
+	, _reading(false)
 	, _writeEnded(false)
 	, _writeQueueSize(DEFAULT_WRITE_QUEUE_SIZE)
 	, _writeQueueFull(false)
+	, _writing(false)
+	, _writeQueue(new RingBuffer<Buffer>(2 * DEFAULT_WRITE_QUEUE_SIZE))
+	, _writeOverflowSize(0)
+	, _writeBatchSize(DEFAULT_WRITE_BATCH_SIZE)
+	, _vectoredWrite(false)
+	, _queuedBytes(0)
+	, _writtenBytes(0)
+	, _syncedBytes(0)
+	, _flushedBytes(0)
+	, _syncScheduled(false)
+	, _progress(0)
 {
+#if defined(RXCW_ENABLE_IO_URING)
+	_ring = IOUring::get();
+#endif
 }
 
 AsyncFile::AsyncFile(const std::string& fileName, const std::string& mode)
 	: AsyncFile()
 {
-	_file = std::fopen(fileName.c_str(), mode.c_str());
+	std::string	fileMode = mode;
+	size_t		mappedFlag = fileMode.find('m');
+
+	if (mappedFlag != std::string::npos)
+	{
+		fileMode.erase(mappedFlag, 1);
+		if (fileMode != "r" && fileMode != "rb")
+			throw std::invalid_argument("memory mapped mode is only available for reading");
+		_mapped = true;
+	}
+
+	size_t		directFlag = fileMode.find('d');
+
+	if (directFlag != std::string::npos)
+	{
+		fileMode.erase(directFlag, 1);
+		if (_mapped || fileMode.find('a') != std::string::npos)
+			throw std::invalid_argument("direct mode is not available in append or memory mapped modes");
+#if !defined(O_DIRECT)
+		throw std::runtime_error("direct mode is not supported on this platform");
+#endif
+		_direct = true;
+	}
+
+	_file = std::fopen(fileName.c_str(), fileMode.c_str());
+	if (!_file)
+		throw std::system_error(errno, std::generic_category(), "Can't open " + fileName);
+
+#if defined(O_DIRECT)
+	// stdio is bypassed in direct mode, only the descriptor needs the flag
+	if (_direct && _file)
+	{
+		int	flags = fcntl(fileno(_file), F_GETFL);
+
+		if (flags < 0 || fcntl(fileno(_file), F_SETFL, flags | O_DIRECT) < 0)
+			throw std::system_error(errno, std::generic_category(), "Can't open " + fileName + " in direct mode");
+	}
+#endif
+
+	// writing to the file descriptor would desynchronize the stdio read buffer of read/write modes
+	_vectoredWrite = fileMode.find('r') == std::string::npos && fileMode.find('+') == std::string::npos;
+
+	if (_mapped && _file)
+		mapFile();
 }
 
 AsyncFile::~AsyncFile(void)
 {
-	if (!_closed)
+	_lifetime.unsubscribe();
+	unmapFile();
+
+	std::unique_lock<std::shared_mutex>	lock(_closeMutex);
+
+	if (!_closed.exchange(true) && _file)
 		std::fclose(_file);
 }
 
-void		AsyncFile::exceptionHandler(const StreamBase<std::string>::ErrorFunction& handler)
+void		AsyncFile::exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler)
 {
 	_errorHandler = handler;
 }
 
-void		AsyncFile::endHandler(const ReadStream<std::string>::EndFunction& handler)
+void		AsyncFile::endHandler(const ReadStream<Buffer>::EndFunction& handler)
 {
 	_endHandler = handler;
 }
 
-void		AsyncFile::handler(const ReadStream<std::string>::DataFunction& handler)
+void		AsyncFile::handler(const ReadStream<Buffer>::DataFunction& handler)
 {
 	_dataHandler = handler;
 }
 
 void		AsyncFile::pause()
 {
-	if (!_paused)
-	{
-		_paused = true;
-	}
+	// the read loop stops on its next chunk
+	if (!_paused.exchange(true))
+		post([this]()
+			{
+				// the consumer can't keep up, read smaller chunks
+				_readBufferSize = std::max(_minReadBufferSize.load(), _readBufferSize / 2);
+				adviseReadAhead(false);
+			});
 }
 
 void		AsyncFile::resume()
 {
-	if (_paused)
+	if (!_closed && _paused.exchange(false))
 	{
-		_paused = false;
-		rxInternalRead()
-			.observeOn(rxcpp::observe_on_new_thread())
-			.repeatUntil([this]() {
-				return _paused || _readEnded;
+		Completable::defer([this]()
+			{
+				// a single read loop per file keeps the chunks ordered
+				if (_reading || _paused || _closed)
+					return Completable::complete();
+				_reading = true;
+				adviseReadAhead(true);
+				return rxInternalRead()
+					.observeOn(rxcpp::observe_on_one_worker(_strand))
+					.repeatUntil([this]() {
+						return _paused || _readEnded || _closed;
+					})
+					.doOnTerminate([this]() {
+						_reading = false;
+					});
 			})
+			.subscribeOn(rxcpp::synchronize_in_one_worker(_strand))
 			.subscribe(
 				[]()
 				{
@@ -114,44 +256,162 @@ void		AsyncFile::resume()
 				[this](std::exception_ptr e)
 				{
 					_paused = true;
+					if (_errorHandler)
+						_errorHandler(e);
 				});
 	}
 }
 
-void		AsyncFile::drainHandler(const WriteStream<std::string>::DrainFunction& handler)
+Completable	AsyncFile::rxPipeTo(WriteStream<Buffer>& writeStream)
+{
+	return rxPipeTo(writeStream, ProgressFunction());
+}
+
+Completable	AsyncFile::rxPipeTo(WriteStream<Buffer>& writeStream, const ProgressFunction& onProgress)
+{
+	return Completable::defer([this, &writeStream, onProgress]()
+		{
+#if defined(__linux__)
+			AsyncFile*	destination = dynamic_cast<AsyncFile*>(&writeStream);
+
+			// pending writes must reach the file before the kernel writes after them, direct files don't use the stdio position
+			if (destination && !destination->_writing && !destination->writesQueued() && !_direct && !destination->_direct)
+				return rxKernelCopyTo(*destination, onProgress);
+#endif
+			_progressHandler = onProgress;
+			_progress = 0;
+			return ReadStream<Buffer>::rxPipeTo(writeStream);
+		})
+		.subscribeOn(rxcpp::synchronize_in_one_worker(_strand));
+}
+
+void		AsyncFile::setReadBufferSize(size_t size)
+{
+	if (!size)
+		throw std::invalid_argument("size must be greater than 0");
+
+	_minReadBufferSize = size;
+	_maxReadBufferSize = size;
+	_readBufferSize = size;
+}
+
+void		AsyncFile::setAdaptiveReadBufferSize(size_t minSize, size_t maxSize)
+{
+	if (!minSize)
+		throw std::invalid_argument("minSize must be greater than 0");
+	if (maxSize < minSize)
+		throw std::invalid_argument("maxSize must be greater than or equal to minSize");
+
+	_minReadBufferSize = minSize;
+	_maxReadBufferSize = maxSize;
+	_readBufferSize = minSize;
+}
+
+size_t		AsyncFile::readBufferSize()
+{
+	return _readBufferSize;
+}
+
+void		AsyncFile::drainHandler(const WriteStream<Buffer>::DrainFunction& handler)
 {
 	_drainHandler = handler;
 }
 
 void		AsyncFile::end()
 {
-	if (!_writeEnded)
+	if (!_writeEnded.exchange(true))
+		post([this]()
+			{
+				// a running write loop closes the file once the queue is drained
+				if (!_writing)
+					close();
+			});
+}
+
+Completable	AsyncFile::rxEnd()
+{
+	return Completable::create([this](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
 	{
-		_writeEnded = true;
-		_closed = true;
-		std::fclose(_file);
-	}
+		if (_closed)
+		{
+			onComplete();
+			return ;
+		}
+		_endWaiters.push_back({ onComplete, onError });
+		end();
+	})
+	.subscribeOn(rxcpp::synchronize_in_one_worker(_strand));
 }
 
-void		AsyncFile::write(const std::string& data)
+void		AsyncFile::write(const Buffer& data)
 {
-	_writeQueue.push_back(data);
+	write(Buffer(data));
+}
 
-	if (_writeQueue.size() >= _writeQueueSize)
-		_writeQueueFull = true;
+void		AsyncFile::write(Buffer&& data)
+{
+	size_t	size = data.size();
 
-	rxInternalWrite()
-		.observeOn(rxcpp::observe_on_new_thread())
-		.repeatUntil([this]()
-			{
-				return _writeQueue.empty();
-			})
+	if (_writeEnded)
+		throw std::logic_error("can't write to an ended file");
+	{
+		std::lock_guard<std::mutex>	lock(_writeMutex);
+
+		// once the queue is full, the writes wait in the overflow list behind the ones already there
+		if (!_writeOverflow.empty() || !_writeQueue->push(std::move(data)))
+		{
+			_writeOverflow.push_back(std::move(data));
+			_writeOverflowSize++;
+		}
+		_queuedBytes += size;
+
+		if (_writeQueue->size() + _writeOverflowSize >= _writeQueueSize)
+		{
+			_writeQueueFull = true;
+			// the write loop may have drained the queue before the flag was set, and would never clear it
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (writeQueueDrained())
+				_writeQueueFull = false;
+		}
+	}
+
+	Completable::defer([this]()
+		{
+			// a single write loop per file keeps the writes ordered
+			if (_writing)
+				return Completable::complete();
+			_writing = true;
+			return rxInternalWrite()
+				.observeOn(rxcpp::observe_on_one_worker(_strand))
+				.doOnComplete([this]()
+					{
+						syncIfNeeded();
+					})
+				.repeatUntil([this]()
+					{
+						std::lock_guard<std::mutex>	lock(_writeMutex);
+
+						refillWriteQueue();
+						return _writeQueue->empty();
+					})
+				.doOnTerminate([this]()
+					{
+						_writing = false;
+						// a size set while writing is applied once the queue is no longer consumed
+						resizeWriteQueue();
+						if (_writeEnded)
+							close();
+					});
+		})
+		.subscribeOn(rxcpp::synchronize_in_one_worker(_strand))
 		.subscribe(
 			[]()
 			{
 			},
 			[this](std::exception_ptr e)
 			{
+				if (_errorHandler)
+					_errorHandler(e);
 			});
 }
 
@@ -160,10 +420,17 @@ void		AsyncFile::setWriteQueueMaxSize(size_t size)
 	if (!size)
 		throw std::invalid_argument("size must be greater than 0");
 
-	_writeQueueSize = size;
+	// the queue is consumed on the strand, it can only be replaced there
+	post([this, size]()
+		{
+			_writeQueueSize = size;
+			resizeWriteQueue();
+
+			std::lock_guard<std::mutex>	lock(_writeMutex);
 
-	if (_writeQueue.size() >= _writeQueueSize)
-		_writeQueueFull = true;
+			if (_writeQueue->size() + _writeOverflowSize >= _writeQueueSize)
+				_writeQueueFull = true;
+		});
 }
 
 bool		AsyncFile::writeQueueFull()
@@ -171,29 +438,186 @@ bool		AsyncFile::writeQueueFull()
 	return _writeQueueFull;
 }
 
+void		AsyncFile::setWriteBatchSize(size_t size)
+{
+	if (!size)
+		throw std::invalid_argument("size must be greater than 0");
+
+	_writeBatchSize = size;
+}
+
+Single<Buffer>	AsyncFile::rxReadAt(uint64_t offset, size_t length)
+{
+	return Single<Buffer>::create([this, offset, length](Single<Buffer>::SuccessFunction onSuccess, Single<Buffer>::ErrorFunction onError)
+	{
+		// direct mode reads the aligned blocks around the requested range
+		size_t	head = _direct ? static_cast<size_t>(offset % DIRECT_IO_ALIGNMENT) : 0;
+		size_t	readLength = _direct ? alignDirect(head + length) : length;
+		Buffer	buffer = BufferPool::acquire(readLength);
+
+		std::shared_lock<std::shared_mutex>	lock(_closeMutex);
+
+		if (_closed)
+		{
+			lock.unlock();
+			onError(std::make_exception_ptr(std::logic_error("can't read a closed file")));
+			return ;
+		}
+
+#if defined(RXCW_ENABLE_IO_URING)
+		if (_ring)
+		{
+			// the ring holds its own reference to the file once the request is submitted
+			// regular files only return less than requested at the end of the file
+			_ring->read(fileno(_file), buffer.data(), buffer.size(), offset - head,
+				[buffer, head, length, onSuccess, onError](ssize_t result)
+				{
+					if (result < 0)
+						onError(std::make_exception_ptr(std::system_error(static_cast<int>(-result), std::generic_category(), "Error while reading file")));
+					else
+						onSuccess(buffer.slice(0, static_cast<size_t>(result)).slice(std::min(head, static_cast<size_t>(result)), length));
+				});
+			return ;
+		}
+#endif
+
+#if defined(_WIN32)
+		lock.unlock();
+		onError(std::make_exception_ptr(std::runtime_error("positional reads are not supported on this platform")));
+#else
+		size_t	size = 0;
+
+		while (size < readLength)
+		{
+			ssize_t	result = pread(fileno(_file), buffer.data() + size, readLength - size, static_cast<off_t>(offset - head + size));
+
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result < 0)
+			{
+				int	error = errno;
+
+				lock.unlock();
+				onError(std::make_exception_ptr(std::system_error(error, std::generic_category(), "Error while reading file")));
+				return ;
+			}
+			if (result == 0)
+				break;
+			size += static_cast<size_t>(result);
+			// a short direct read is the end of the file, and the next offset would be unaligned
+			if (_direct && size % DIRECT_IO_ALIGNMENT)
+				break;
+		}
+		lock.unlock();
+		onSuccess(buffer.slice(0, size).slice(std::min(head, size), length));
+#endif
+	})
+	.subscribeOn(rxcpp::synchronize_in_one_worker(IOScheduler::scheduler()));
+}
+
+Completable		AsyncFile::rxWriteAt(uint64_t offset, const Buffer& data)
+{
+	return Completable::create([this, offset, data](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
+	{
+		if (_direct)
+		{
+			if (offset % DIRECT_IO_ALIGNMENT || data.size() % DIRECT_IO_ALIGNMENT)
+			{
+				onError(std::make_exception_ptr(std::invalid_argument("offset and size must be aligned on " + std::to_string(DIRECT_IO_ALIGNMENT) + " bytes in direct mode")));
+				return ;
+			}
+			if (reinterpret_cast<uintptr_t>(data.data()) % DIRECT_IO_ALIGNMENT)
+			{
+				Buffer	aligned = BufferPool::acquire(data.size());
+
+				std::memcpy(aligned.data(), data.data(), data.size());
+				writeAt(offset, aligned, onComplete, onError);
+				return ;
+			}
+		}
+		writeAt(offset, data, onComplete, onError);
+	})
+	.subscribeOn(rxcpp::synchronize_in_one_worker(IOScheduler::scheduler()));
+}
+
+void		AsyncFile::setSyncPolicy(const SyncPolicy& policy)
+{
+	_syncPolicy = policy;
+}
+
+Completable		AsyncFile::rxSync()
+{
+	return Completable::create([this](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
+	{
+		if (_closed)
+		{
+			onError(std::make_exception_ptr(std::logic_error("can't sync a closed file")));
+			return ;
+		}
+		// positional writes are covered too, the whole file is synced
+		_syncWaiters.push_back({ _queuedBytes, onComplete, onError });
+		syncIfNeeded();
+	})
+	.subscribeOn(rxcpp::synchronize_in_one_worker(_strand));
+}
+
 Completable	AsyncFile::rxInternalRead()
 {
 	return Completable::create([this](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError) {
-		std::string	buffer;
-
-		buffer.resize(_readBufferSize);
-		size_t	result = std::fread(&buffer[0], 1, _readBufferSize, _file);
-		if (result > 0)
+		// the file was closed between two chunks
+		if (_closed)
 		{
-			buffer.resize(result);
-			_dataHandler(buffer);
 			onComplete();
+			return ;
 		}
-		else if (result == 0)
+
+		if (_mapped)
 		{
-			_readEnded = true;
-			_endHandler();
-			onComplete();
+			size_t	size = std::min(_readBufferSize.load(), _mappingSize - _mappingOffset);
+
+			// chunks are views into the mapping, which is unmapped once the file and all chunks are released
+			Buffer	buffer(_mapping, _mapping.get() + _mappingOffset, size);
+			_mappingOffset += size;
+			if (_mappingOffset >= _mappingAdvisedEnd)
+				prefetchMapping();
+			readCompleted(buffer, size, onComplete);
+			return ;
 		}
-		else
+
+		if (_direct)
+		{
+			readDirect(onComplete, onError);
+			return ;
+		}
+
+#if defined(RXCW_ENABLE_IO_URING)
+		if (_ring)
 		{
-			onError(std::make_exception_ptr(std::runtime_error("Error " + std::to_string(result) + " while reading file")));
+			Buffer	buffer = BufferPool::acquire(_readBufferSize);
+
+			// the data handler is called from the ring completion thread
+			_ring->read(fileno(_file), buffer.data(), buffer.size(), IOUring::CURRENT_POSITION,
+				[this, worker = _worker, buffer, onComplete, onError](ssize_t result)
+				{
+					// back to the strand, the handler must not run on the ring completion thread, and the file may be gone
+					worker.schedule([this, buffer, result, onComplete, onError](const rxcpp::schedulers::schedulable&)
+						{
+							if (result < 0)
+								onError(std::make_exception_ptr(std::system_error(static_cast<int>(-result), std::generic_category(), "Error while reading file")));
+							else
+								readCompleted(buffer, static_cast<size_t>(result), onComplete);
+						});
+				});
+			return ;
 		}
+#endif
+
+		Buffer	buffer = BufferPool::acquire(_readBufferSize);
+		size_t	result = std::fread(buffer.data(), 1, buffer.size(), _file);
+		if (result == 0 && std::ferror(_file))
+			onError(std::make_exception_ptr(std::runtime_error("Error while reading file")));
+		else
+			readCompleted(buffer, result, onComplete);
 	});
 }
 
@@ -201,48 +625,686 @@ Completable	AsyncFile::rxInternalWrite()
 {
 	return Completable::create([this](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
 	{
-		if (!_writeQueue.empty())
+		Buffer*	data = _writeQueue->front();
+
+		if (!data || data->empty())
 		{
-			std::string	data = _writeQueue.front();
-			_writeQueue.pop_front();
-			if (!data.empty())
-			{
-				size_t	result = std::fwrite(&data[0], 1, data.size(), _file);
-				if (result > 0)
-				{
-					if (result < data.size())
-					{
-						_writeQueue.push_front(data.substr(result));
-					}
-				}
-				else
+			if (data)
+				_writeQueue->pop();
+			writeCompleted(onComplete);
+			return ;
+		}
+
+		if (_direct)
+		{
+			writeDirect(onComplete, onError);
+			return ;
+		}
+
+#if defined(RXCW_ENABLE_IO_URING)
+		if (_ring)
+		{
+			size_t	count = prepareWriteVector();
+
+			// chunks stay in the queue until they are fully written, keeping the vector buffers alive
+			_ring->writev(fileno(_file), _writeVector.data(), count, IOUring::CURRENT_POSITION,
+				[this, worker = _worker, onComplete, onError](ssize_t result)
 				{
-					onError(std::make_exception_ptr(std::runtime_error("Error " + std::to_string(result) + " while writing file")));
-					return ;
-				}
+					// back to the strand, the queue is only consumed there, unless the file is gone
+					worker.schedule([this, result, onComplete, onError](const rxcpp::schedulers::schedulable&)
+						{
+							if (result < 0)
+							{
+								onError(std::make_exception_ptr(std::system_error(static_cast<int>(-result), std::generic_category(), "Error while writing file")));
+								return ;
+							}
+							if (result == 0)
+							{
+								onError(std::make_exception_ptr(std::runtime_error("Error 0 while writing file")));
+								return ;
+							}
+							consumeWritten(static_cast<size_t>(result));
+							writeCompleted(onComplete);
+						});
+				});
+			return ;
+		}
+#endif
+
+#if !defined(_WIN32)
+		if (_vectoredWrite)
+		{
+			size_t	count = prepareWriteVector();
+			ssize_t	result = ::writev(fileno(_file), _writeVector.data(), static_cast<int>(count));
+
+			if (result < 0 && errno != EINTR)
+			{
+				onError(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "Error while writing file")));
+				return ;
 			}
+			if (result > 0)
+				consumeWritten(static_cast<size_t>(result));
+			writeCompleted(onComplete);
+			return ;
+		}
+#endif
+
+		size_t	result = std::fwrite(std::as_const(*data).data(), 1, data->size(), _file);
+		if (result > 0)
+		{
+			_writtenBytes += result;
+			if (result < data->size())
+				*data = data->slice(result);
+			else
+				_writeQueue->pop();
+		}
+		else
+		{
+			onError(std::make_exception_ptr(std::runtime_error("Error " + std::to_string(result) + " while writing file")));
+			return ;
+		}
+
+		writeCompleted(onComplete);
+	});
+}
+
+void		AsyncFile::readCompleted(const Buffer& buffer, size_t size, const Completable::CompleteFunction& onComplete)
+{
+	if (size > 0)
+	{
+		_dataHandler(buffer.slice(0, size));
+		_progress += size;
+		if (_progressHandler)
+			_progressHandler(_progress);
+
+		// the consumer keeps up, read bigger chunks
+		if (!_paused && _readBufferSize < _maxReadBufferSize && ++_readStreak >= ADAPTIVE_READ_GROWTH_STREAK)
+		{
+			_readStreak = 0;
+			_readBufferSize = std::min(_maxReadBufferSize.load(), _readBufferSize * 2);
+			prefetchFile();
 		}
+		else if (_paused)
+			_readStreak = 0;
+	}
+	else
+	{
+		_readEnded = true;
+		_endHandler();
+	}
+	onComplete();
+}
+
+void		AsyncFile::mapFile()
+{
+#if defined(_WIN32)
+	throw std::runtime_error("memory mapped mode is not supported on this platform");
+#else
+	struct stat	fileStat;
+
+	if (fstat(fileno(_file), &fileStat) == -1)
+		throw std::system_error(errno, std::generic_category(), "Error while mapping file");
+
+	// an empty file can't be mapped, reading it just ends immediately
+	_mappingSize = static_cast<size_t>(fileStat.st_size);
+	if (!_mappingSize)
+		return ;
+
+	void*	mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fileno(_file), 0);
+	if (mapping == MAP_FAILED)
+		throw std::system_error(errno, std::generic_category(), "Error while mapping file");
 
-		if (_writeQueueFull)
+	size_t	mappingSize = _mappingSize;
+	_mapping = std::shared_ptr<const char>(static_cast<const char*>(mapping), [mappingSize](const char* data)
+	{
+		munmap(const_cast<char*>(data), mappingSize);
+	});
+#endif
+}
+
+void		AsyncFile::unmapFile()
+{
+	// chunks still in use keep the mapping alive
+	_mapping.reset();
+}
+
+void		AsyncFile::adviseReadAhead(bool sequential)
+{
+#if !defined(_WIN32)
+	if (!_mapped)
+	{
+#if defined(POSIX_FADV_SEQUENTIAL)
+		if (_file && !_direct)
+			posix_fadvise(fileno(_file), 0, 0, sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+#endif
+		if (sequential)
+			prefetchFile();
+		return ;
+	}
+
+	if (!_mapping)
+		return ;
+
+	// read-ahead is only aggressive while the data is being consumed
+	madvise(const_cast<char*>(_mapping.get()), _mappingSize, sequential ? MADV_SEQUENTIAL : MADV_NORMAL);
+	if (sequential)
+		prefetchMapping();
+#endif
+}
+
+void		AsyncFile::prefetchMapping()
+{
+#if !defined(_WIN32)
+	size_t	pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	size_t	start = _mappingOffset - _mappingOffset % pageSize;
+	size_t	end = std::min(_mappingSize, _mappingOffset + MAPPED_READ_AHEAD_SIZE);
+
+	if (start < end)
+		madvise(const_cast<char*>(_mapping.get()) + start, end - start, MADV_WILLNEED);
+	_mappingAdvisedEnd = end;
+#endif
+}
+
+void		AsyncFile::prefetchFile()
+{
+#if defined(POSIX_FADV_WILLNEED)
+	off_t	position = _file && !_direct ? ftello(_file) : -1;
+
+	// ask the kernel for the next two chunks
+	if (position >= 0 && !_mapped && !_direct)
+		posix_fadvise(fileno(_file), position, static_cast<off_t>(2 * _readBufferSize), POSIX_FADV_WILLNEED);
+#endif
+}
+
+void		AsyncFile::writeCompleted(const Completable::CompleteFunction& onComplete)
+{
+	// pairs with the fence in write, either this sees the full flag or write sees the drained queue
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (_writeQueueFull && writeQueueDrained() && _writeQueueFull.exchange(false) && _drainHandler)
+		_drainHandler();
+
+	onComplete();
+}
+
+Completable	AsyncFile::rxKernelCopyTo(AsyncFile& destination, const ProgressFunction& onProgress)
+{
+#if defined(__linux__)
+	enum	Method
+	{
+		COPY_FILE_RANGE,
+		SENDFILE,
+		USER_SPACE
+	};
+
+	struct	State
+	{
+		Method		method;
+		off_t		offset;
+		uint64_t	copied;
+		bool		done;
+	};
+
+	std::shared_ptr<State>	state = std::make_shared<State>();
+
+	state->method = COPY_FILE_RANGE;
+	state->offset = _mapped ? static_cast<off_t>(_mappingOffset) : ftello(_file);
+	state->copied = 0;
+	state->done = false;
+	std::fflush(destination._file);
+
+	return Completable::create([this, &destination, state, onProgress](Completable::CompleteFunction onComplete, Completable::ErrorFunction onError)
 		{
-			if (_writeQueueSize == 1)
+			ssize_t	result = -1;
+
+			if (state->method == COPY_FILE_RANGE)
 			{
-				if (_writeQueue.empty())
+				result = copy_file_range(fileno(_file), &state->offset, fileno(destination._file), nullptr, KERNEL_COPY_STEP_SIZE, 0);
+				// not supported by these files (other file system, append mode...), try sendfile instead
+				if (result < 0 && !state->copied && (errno == EXDEV || errno == EINVAL || errno == EBADF || errno == ENOSYS || errno == EOPNOTSUPP))
+					state->method = SENDFILE;
+			}
+			if (state->method == SENDFILE)
+			{
+				result = sendfile(fileno(destination._file), fileno(_file), &state->offset, KERNEL_COPY_STEP_SIZE);
+				if (result < 0 && !state->copied && (errno == EINVAL || errno == ENOSYS))
 				{
-					_writeQueueFull = false;
-					_drainHandler();
+					state->method = USER_SPACE;
+					state->done = true;
+					onComplete();
+					return ;
 				}
 			}
+
+			if (result < 0)
+			{
+				if (errno == EINTR || errno == EAGAIN)
+					onComplete();
+				else
+					onError(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "Error while copying file")));
+				return ;
+			}
+
+			if (result == 0)
+				state->done = true;
 			else
 			{
-				if (_writeQueue.size() < _writeQueueSize / 2)
+				state->copied += static_cast<uint64_t>(result);
+				if (onProgress)
+					onProgress(state->copied);
+			}
+			onComplete();
+		})
+		.observeOn(rxcpp::observe_on_one_worker(_strand))
+		.repeatUntil([state]()
+			{
+				return state->done;
+			})
+		.andThen(Completable::defer([this, &destination, state, onProgress]()
+			{
+				if (state->method == USER_SPACE)
+				{
+					_progressHandler = onProgress;
+					_progress = 0;
+					return ReadStream<Buffer>::rxPipeTo(destination);
+				}
+
+				if (_mapped)
+					_mappingOffset = static_cast<size_t>(state->offset);
+				else
+					fseeko(_file, state->offset, SEEK_SET);
+				_readEnded = true;
+				return destination.rxEnd();
+			}));
+#else
+	return ReadStream<Buffer>::rxPipeTo(destination);
+#endif
+}
+
+void		AsyncFile::writeAt(uint64_t offset, const Buffer& data, const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError)
+{
+	if (data.empty())
+	{
+		onComplete();
+		return ;
+	}
+
+	std::shared_lock<std::shared_mutex>	lock(_closeMutex);
+
+	if (_closed)
+	{
+		lock.unlock();
+		onError(std::make_exception_ptr(std::logic_error("can't write to a closed file")));
+		return ;
+	}
+
+#if defined(RXCW_ENABLE_IO_URING)
+	if (_ring)
+	{
+		// the ring holds its own reference to the file once the request is submitted
+		_ring->write(fileno(_file), data.data(), data.size(), offset,
+			[this, offset, data, onComplete, onError](ssize_t result)
+			{
+				if (result <= 0)
 				{
-					_writeQueueFull = false;
-					_drainHandler();
+					onError(std::make_exception_ptr(std::system_error(result ? static_cast<int>(-result) : EIO, std::generic_category(), "Error while writing file")));
+					return ;
 				}
+				// write what is left after a short write
+				writeAt(offset + static_cast<uint64_t>(result), data.slice(static_cast<size_t>(result)), onComplete, onError);
+			});
+		return ;
+	}
+#endif
+
+#if defined(_WIN32)
+	lock.unlock();
+	onError(std::make_exception_ptr(std::runtime_error("positional writes are not supported on this platform")));
+#else
+	size_t	size = 0;
+
+	while (size < data.size())
+	{
+		ssize_t	result = pwrite(fileno(_file), data.data() + size, data.size() - size, static_cast<off_t>(offset + size));
+
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+		{
+			int	error = result ? errno : EIO;
+
+			lock.unlock();
+			onError(std::make_exception_ptr(std::system_error(error, std::generic_category(), "Error while writing file")));
+			return ;
+		}
+		size += static_cast<size_t>(result);
+	}
+	lock.unlock();
+	onComplete();
+#endif
+}
+
+void		AsyncFile::readDirect(const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError)
+{
+#if defined(_WIN32)
+	onError(std::make_exception_ptr(std::runtime_error("direct mode is not supported on this platform")));
+#else
+	// only a short read, at the end of the file, leaves the offset unaligned
+	if (_directOffset % DIRECT_IO_ALIGNMENT)
+	{
+		readCompleted(Buffer(), 0, onComplete);
+		return ;
+	}
+
+	Buffer	buffer = BufferPool::acquire(alignDirect(_readBufferSize));
+	ssize_t	result;
+
+	while ((result = pread(fileno(_file), buffer.data(), buffer.size(), static_cast<off_t>(_directOffset))) < 0 && errno == EINTR)
+		;
+	if (result < 0)
+	{
+		onError(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "Error while reading file")));
+		return ;
+	}
+	_directOffset += static_cast<uint64_t>(result);
+	readCompleted(buffer, static_cast<size_t>(result), onComplete);
+#endif
+}
+
+void		AsyncFile::writeDirect(const Completable::CompleteFunction& onComplete, const Completable::ErrorFunction& onError)
+{
+#if defined(_WIN32)
+	onError(std::make_exception_ptr(std::runtime_error("direct mode is not supported on this platform")));
+#else
+	// a block being filled keeps its size, even if the batch size changed
+	if (!_directBuffered)
+	{
+		size_t	size = alignDirect(_writeBatchSize);
+
+		if (size > BufferPool::MAX_BLOCK_SIZE)
+			size = BufferPool::MAX_BLOCK_SIZE;
+
+		if (_directBuffer.size() != size)
+			_directBuffer = BufferPool::acquire(size);
+	}
+
+	Buffer*	data;
+
+	while (_directBuffered < _directBuffer.size() && (data = _writeQueue->front()))
+	{
+		size_t	size = std::min(data->size(), _directBuffer.size() - _directBuffered);
+
+		std::memcpy(_directBuffer.data() + _directBuffered, std::as_const(*data).data(), size);
+		_directBuffered += size;
+		consumeWritten(size);
+	}
+
+	// a partial block waits for more data, or for the end of the file
+	if (_directBuffered == _directBuffer.size())
+	{
+		size_t	size = 0;
+
+		while (size < _directBuffered)
+		{
+			ssize_t	result = pwrite(fileno(_file), _directBuffer.data() + size, _directBuffered - size, static_cast<off_t>(_directOffset + size));
+
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result <= 0)
+			{
+				onError(std::make_exception_ptr(std::system_error(result ? errno : EIO, std::generic_category(), "Error while writing file")));
+				return ;
 			}
+			size += static_cast<size_t>(result);
 		}
+		_directOffset += size;
+		_directBuffered = 0;
+	}
 
-		onComplete();
-	});
+	writeCompleted(onComplete);
+#endif
+}
+
+int			AsyncFile::flushDirect()
+{
+#if defined(O_DIRECT)
+	if (!_direct || !_directBuffered)
+		return 0;
+
+	int		flags = fcntl(fileno(_file), F_GETFL);
+	size_t	size = 0;
+	int		error = 0;
+
+	// the tail is not a whole block, write it through the page cache, the block is written again once complete
+	if (flags < 0 || fcntl(fileno(_file), F_SETFL, flags & ~O_DIRECT) < 0)
+		return errno;
+	while (!error && size < _directBuffered)
+	{
+		ssize_t	result = pwrite(fileno(_file), _directBuffer.data() + size, _directBuffered - size, static_cast<off_t>(_directOffset + size));
+
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			error = result ? errno : EIO;
+		else
+			size += static_cast<size_t>(result);
+	}
+	if (fcntl(fileno(_file), F_SETFL, flags) < 0 && !error)
+		error = errno;
+	return error;
+#else
+	return 0;
+#endif
+}
+
+void		AsyncFile::post(const std::function<void()>& action)
+{
+	_worker.schedule([action](const rxcpp::schedulers::schedulable&)
+		{
+			action();
+		});
+}
+
+void		AsyncFile::close()
+{
+	if (_closed.exchange(true))
+		return ;
+
+	int	error = _syncPolicy.syncOnEnd || !_syncWaiters.empty() ? syncFile() : flushDirect();
+
+	{
+		std::unique_lock<std::shared_mutex>	lock(_closeMutex);
+
+		if (std::fclose(_file) && !error)
+			error = errno;
+	}
+
+	std::exception_ptr	exception = error ? std::make_exception_ptr(std::system_error(error, std::generic_category(), "Error while closing file")) : nullptr;
+	std::deque<SyncWaiter>	syncWaiters;
+	std::vector<std::pair<Completable::CompleteFunction, Completable::ErrorFunction>>	endWaiters;
+	StreamBase<Buffer>::ErrorFunction	errorHandler = exception ? _errorHandler : nullptr;
+
+	// the callbacks may destroy the file, nothing is used from it once they run
+	syncWaiters.swap(_syncWaiters);
+	endWaiters.swap(_endWaiters);
+	// waiters for data still queued can't be satisfied anymore
+	for (const SyncWaiter& waiter : syncWaiters)
+		waiter.onError(std::make_exception_ptr(std::runtime_error("file closed before the data was written")));
+	for (const std::pair<Completable::CompleteFunction, Completable::ErrorFunction>& waiter : endWaiters)
+	{
+		if (exception)
+			waiter.second(exception);
+		else
+			waiter.first();
+	}
+	if (errorHandler)
+		errorHandler(exception);
+}
+
+void		AsyncFile::syncIfNeeded()
+{
+	uint64_t	written = _writtenBytes;
+
+#if defined(__linux__)
+	// start the writeback early, so that the next sync has less to wait for
+	if (_syncPolicy.flushBytes && written - _flushedBytes >= _syncPolicy.flushBytes)
+	{
+		sync_file_range(fileno(_file), 0, 0, SYNC_FILE_RANGE_WRITE);
+		_flushedBytes = written;
+	}
+#endif
+
+	if (_syncPolicy.bytes && written - _syncedBytes >= _syncPolicy.bytes)
+	{
+		syncFile();
+		return ;
+	}
+
+	if (_syncPolicy.interval.count())
+	{
+		if (!_syncScheduled && (written > _syncedBytes || !_syncWaiters.empty()))
+		{
+			_syncScheduled = true;
+			_worker.schedule(_worker.now() + _syncPolicy.interval, [this](const rxcpp::schedulers::schedulable&)
+				{
+					_syncScheduled = false;
+					if (_closed)
+						return ;
+					syncFile();
+					// writes may have come during the sync
+					syncIfNeeded();
+				});
+		}
+		return ;
+	}
+
+	// without interval, waiters are served as soon as their data is written
+	if (!_syncWaiters.empty() && written >= _syncWaiters.front().target)
+		syncFile();
+}
+
+int			AsyncFile::syncFile()
+{
+	uint64_t	written = _writtenBytes;
+	int			error = flushDirect();
+
+	if (!error && std::fflush(_file))
+		error = errno;
+#if defined(_WIN32)
+	if (!error && _commit(_fileno(_file)))
+		error = errno;
+#elif defined(__APPLE__)
+	if (!error && fsync(fileno(_file)))
+		error = errno;
+#else
+	if (!error && (_syncPolicy.metadata ? fsync(fileno(_file)) : fdatasync(fileno(_file))))
+		error = errno;
+#endif
+
+	if (error)
+	{
+		std::exception_ptr	exception = std::make_exception_ptr(std::system_error(error, std::generic_category(), "Error while syncing file"));
+
+		for (const SyncWaiter& waiter : _syncWaiters)
+			waiter.onError(exception);
+		_syncWaiters.clear();
+		return error;
+	}
+
+	_syncedBytes = written;
+	while (!_syncWaiters.empty() && _syncWaiters.front().target <= written)
+	{
+		SyncWaiter	waiter = _syncWaiters.front();
+
+		_syncWaiters.pop_front();
+		waiter.onComplete();
+	}
+	return 0;
+}
+
+size_t		AsyncFile::prepareWriteVector()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	size_t	bytes = 0;
+
+	_writeVector.clear();
+	for (size_t i = 0; _writeVector.size() < WRITE_VECTOR_MAX_SIZE; i++)
+	{
+		Buffer*	data = _writeQueue->peek(i);
+
+		// the first chunk is always written, even if it exceeds the batch size
+		if (!data || (bytes && bytes + data->size() > _writeBatchSize))
+			break;
+		if (data->empty())
+			continue;
+		// the chunks are only read, mapped ones stay uncopied
+		_writeVector.push_back({ const_cast<char*>(std::as_const(*data).data()), data->size() });
+		bytes += data->size();
+	}
+	return _writeVector.size();
+#endif
+}
+
+void		AsyncFile::consumeWritten(size_t size)
+{
+	Buffer*	data;
+
+	_writtenBytes += size;
+	while ((data = _writeQueue->front()) && (size || data->empty()))
+	{
+		if (size < data->size())
+		{
+			*data = data->slice(size);
+			return ;
+		}
+		size -= data->size();
+		_writeQueue->pop();
+	}
+}
+
+bool		AsyncFile::writeQueueDrained() const
+{
+	if (_writeOverflowSize)
+		return false;
+	if (_writeQueueSize == 1)
+		return _writeQueue->empty();
+	return _writeQueue->size() < _writeQueueSize / 2;
+}
+
+void		AsyncFile::refillWriteQueue()
+{
+	// the write mutex is held by the caller
+	while (!_writeOverflow.empty() && _writeQueue->push(std::move(_writeOverflow.front())))
+	{
+		_writeOverflow.pop_front();
+		_writeOverflowSize--;
+	}
+}
+
+void		AsyncFile::resizeWriteQueue()
+{
+	std::lock_guard<std::mutex>	lock(_writeMutex);
+
+	// called on the strand, no write loop consumes the queue while it's replaced
+	if (_writing || _writeQueue->capacity() >= 2 * _writeQueueSize)
+		return ;
+
+	std::unique_ptr<RingBuffer<Buffer>>	queue(new RingBuffer<Buffer>(2 * _writeQueueSize));
+	Buffer*								data;
+
+	while ((data = _writeQueue->front()))
+	{
+		queue->push(std::move(*data));
+		_writeQueue->pop();
+	}
+	_writeQueue = std::move(queue);
+	refillWriteQueue();
+}
+
+bool		AsyncFile::writesQueued()
+{
+	std::lock_guard<std::mutex>	lock(_writeMutex);
+
+	return !_writeQueue->empty() || !_writeOverflow.empty();
 }
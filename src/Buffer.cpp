@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Buffer.cpp
+ * Created: 16th October 2026 2:41:12 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 2:41:12 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/Buffer.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+Buffer::Buffer(void)
+	: _size(0)
+	, _readOnly(false)
+{
+}
+
+Buffer::Buffer(size_t size)
+	: _data(new char[size], std::default_delete<char[]>())
+	, _size(size)
+	, _readOnly(false)
+{
+}
+
+Buffer::Buffer(const char* data, size_t size)
+	: Buffer(size)
+{
+	if (size)
+		std::memcpy(_data.get(), data, size);
+}
+
+Buffer::Buffer(const char* data)
+	: Buffer(data, std::strlen(data))
+{
+}
+
+Buffer::Buffer(const std::string& data)
+	: Buffer(data.data(), data.size())
+{
+}
+
+Buffer::Buffer(std::string&& data)
+	: _size(data.size())
+	, _readOnly(false)
+{
+	std::shared_ptr<std::string>	owner = std::make_shared<std::string>(std::move(data));
+
+	_data = std::shared_ptr<char>(owner, &(*owner)[0]);
+}
+
+Buffer::Buffer(const std::shared_ptr<char>& data, size_t size)
+	: _data(data)
+	, _size(size)
+	, _readOnly(false)
+{
+}
+
+Buffer::Buffer(const std::shared_ptr<const void>& owner, const char* data, size_t size)
+	: _data(owner, const_cast<char*>(data))
+	, _size(size)
+	, _readOnly(true)
+{
+}
+
+Buffer::~Buffer(void)
+{
+}
+
+char*				Buffer::data()
+{
+	// the viewed memory may be mapped read-only, writing to it would crash
+	if (_readOnly)
+		*this = Buffer(_data.get(), _size);
+	return _data.get();
+}
+
+const char*			Buffer::data() const
+{
+	return _data.get();
+}
+
+size_t				Buffer::size() const
+{
+	return _size;
+}
+
+bool				Buffer::empty() const
+{
+	return !_size;
+}
+
+Buffer				Buffer::slice(size_t offset, size_t length) const
+{
+	if (offset > _size)
+		throw std::out_of_range("offset " + std::to_string(offset) + " out of range");
+
+	Buffer	result;
+
+	result._data = std::shared_ptr<char>(_data, _data.get() + offset);
+	result._size = std::min(length, _size - offset);
+	result._readOnly = _readOnly;
+	return result;
+}
+
+std::string_view	Buffer::view() const
+{
+	return std::string_view(_data.get(), _size);
+}
+
+std::string			Buffer::toString() const
+{
+	return std::string(_data.get(), _size);
+}
+
+					Buffer::operator std::string() const
+{
+	return toString();
+}
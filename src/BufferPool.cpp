@@ -0,0 +1,293 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: BufferPool.cpp
+ * Created: 16th October 2026 11:02:13 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:02:13 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/BufferPool.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <new>
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+std::mutex						BufferPool::_mutex;
+std::vector<char*>				BufferPool::_blocks[BufferPool::CLASS_COUNT];
+size_t							BufferPool::_globalCacheSize = BufferPool::DEFAULT_GLOBAL_CACHE_SIZE;
+size_t							BufferPool::_globalCachedSize = 0;
+std::atomic<size_t>				BufferPool::_threadCacheSize(BufferPool::DEFAULT_THREAD_CACHE_SIZE);
+
+thread_local BufferPool::ThreadCache	BufferPool::_threadCache;
+thread_local bool						BufferPool::_threadCacheDestroyed = false;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+BufferPool::BufferPool(void)
+{
+}
+
+BufferPool::~BufferPool(void)
+{
+}
+
+Buffer			BufferPool::acquire(size_t size)
+{
+	if (!size)
+		return Buffer();
+	// bigger blocks are not pooled, but keep the alignment
+	if (size > MAX_BLOCK_SIZE)
+	{
+		std::shared_ptr<char>	owner(static_cast<char*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT))), [size](char* block) {
+			::operator delete(block, size, std::align_val_t(BLOCK_ALIGNMENT));
+		});
+
+		return Buffer(owner, size);
+	}
+
+	size_t							sizeClass = BufferPool::sizeClass(size);
+	char*							block = allocate(sizeClass);
+	std::shared_ptr<ReturnQueue>	returns = _threadCacheDestroyed ? nullptr : _threadCache.returns;
+	std::shared_ptr<char>			owner(block, [sizeClass, returns](char* block) {
+		release(block, sizeClass, returns);
+	});
+
+	return Buffer(owner, size);
+}
+
+void			BufferPool::setThreadCacheSize(size_t size)
+{
+	_threadCacheSize = size;
+}
+
+void			BufferPool::setGlobalCacheSize(size_t size)
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	_globalCacheSize = size;
+}
+
+void			BufferPool::clear()
+{
+	if (!_threadCacheDestroyed)
+	{
+		drain();
+		for (size_t sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++)
+		{
+			for (char* block : _threadCache.blocks[sizeClass])
+				free(block, sizeClass);
+			_threadCache.blocks[sizeClass].clear();
+		}
+		_threadCache.size = 0;
+	}
+
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	for (size_t sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++)
+	{
+		for (char* block : _blocks[sizeClass])
+			free(block, sizeClass);
+		_blocks[sizeClass].clear();
+	}
+	_globalCachedSize = 0;
+}
+
+size_t			BufferPool::sizeClass(size_t size)
+{
+	size_t	sizeClass = 0;
+
+	while (blockSize(sizeClass) < size)
+		sizeClass++;
+	return sizeClass;
+}
+
+size_t			BufferPool::blockSize(size_t sizeClass)
+{
+	return MIN_BLOCK_SIZE << sizeClass;
+}
+
+size_t			BufferPool::blockAlignment(size_t sizeClass)
+{
+	// aligning a small block on a whole page would waste most of it
+	return blockSize(sizeClass) < BLOCK_ALIGNMENT ? blockSize(sizeClass) : BLOCK_ALIGNMENT;
+}
+
+char*			BufferPool::allocate(size_t sizeClass)
+{
+	// the thread cache is lock free, try it first
+	if (!_threadCacheDestroyed)
+	{
+		std::vector<char*>&	blocks = _threadCache.blocks[sizeClass];
+
+		if (blocks.empty() && _threadCache.returns->size.load(std::memory_order_relaxed))
+			drain();
+
+		if (!blocks.empty())
+		{
+			char*	block = blocks.back();
+
+			blocks.pop_back();
+			_threadCache.size -= blockSize(sizeClass);
+			return block;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex>	lock(_mutex);
+		std::vector<char*>&			blocks = _blocks[sizeClass];
+
+		if (!blocks.empty())
+		{
+			char*	block = blocks.back();
+
+			blocks.pop_back();
+			_globalCachedSize -= blockSize(sizeClass);
+			return block;
+		}
+	}
+
+	return static_cast<char*>(::operator new(blockSize(sizeClass), std::align_val_t(blockAlignment(sizeClass))));
+}
+
+void			BufferPool::release(char* block, size_t sizeClass, const std::shared_ptr<ReturnQueue>& owner)
+{
+	// blocks acquired once the thread cache was gone, at thread exit, go to the global cache
+	if (!owner)
+	{
+		releaseGlobal(block, sizeClass);
+		return ;
+	}
+	if (!_threadCacheDestroyed && owner == _threadCache.returns)
+	{
+		if (_threadCache.size + blockSize(sizeClass) <= _threadCacheSize)
+		{
+			_threadCache.blocks[sizeClass].push_back(block);
+			_threadCache.size += blockSize(sizeClass);
+			return ;
+		}
+		releaseGlobal(block, sizeClass);
+		return ;
+	}
+
+	{
+		// a consumer thread dropping the blocks of a producer hands them back, instead of piling them up in its own cache
+		std::lock_guard<std::mutex>	lock(owner->mutex);
+
+		if (owner->open && owner->size + blockSize(sizeClass) <= _threadCacheSize)
+		{
+			owner->blocks.emplace_back(block, sizeClass);
+			owner->size += blockSize(sizeClass);
+			return ;
+		}
+	}
+	releaseGlobal(block, sizeClass);
+}
+
+void			BufferPool::releaseGlobal(char* block, size_t sizeClass)
+{
+	{
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		if (_globalCachedSize + blockSize(sizeClass) <= _globalCacheSize)
+		{
+			_blocks[sizeClass].push_back(block);
+			_globalCachedSize += blockSize(sizeClass);
+			return ;
+		}
+	}
+
+	free(block, sizeClass);
+}
+
+void			BufferPool::drain()
+{
+	std::vector<std::pair<char*, size_t>>	blocks;
+
+	{
+		std::lock_guard<std::mutex>	lock(_threadCache.returns->mutex);
+
+		blocks.swap(_threadCache.returns->blocks);
+		_threadCache.returns->size = 0;
+	}
+	for (const std::pair<char*, size_t>& block : blocks)
+		release(block.first, block.second, _threadCache.returns);
+}
+
+void			BufferPool::free(char* block, size_t sizeClass)
+{
+	::operator delete(block, blockSize(sizeClass), std::align_val_t(blockAlignment(sizeClass)));
+}
+
+BufferPool::ThreadCache::ThreadCache(void)
+	: returns(std::make_shared<ReturnQueue>())
+{
+}
+
+BufferPool::ThreadCache::~ThreadCache(void)
+{
+	std::vector<std::pair<char*, size_t>>	returned;
+
+	_threadCacheDestroyed = true;
+	{
+		std::lock_guard<std::mutex>	lock(returns->mutex);
+
+		// the blocks still in use are released to the global cache from now on
+		returns->open = false;
+		returned.swap(returns->blocks);
+		returns->size = 0;
+	}
+
+	// hand the cached blocks over to the other threads
+	for (size_t sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++)
+		for (char* block : blocks[sizeClass])
+			releaseGlobal(block, sizeClass);
+	for (const std::pair<char*, size_t>& block : returned)
+		releaseGlobal(block.first, block.second);
+}
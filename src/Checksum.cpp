@@ -0,0 +1,407 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: Checksum.cpp
+ * Created: 16th October 2026 1:37:15 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 1:37:15 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/Checksum.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+// sse 4.2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <nmmintrin.h>
+#define RXCW_CRC32C_SSE42
+#endif
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+static const uint64_t	XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t	XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t	XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t	XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t	XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static const uint32_t	SHA256_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const std::array<uint32_t, 256>	CRC32C_TABLE = []()
+{
+	std::array<uint32_t, 256>	table;
+
+	// reflected Castagnoli polynomial
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		uint32_t	crc = i;
+
+		for (int bit = 0; bit < 8; bit++)
+			crc = crc & 1 ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+		table[i] = crc;
+	}
+	return table;
+}();
+
+static uint32_t	crc32cSoftware(uint32_t crc, const uint8_t* data, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		crc = CRC32C_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	return crc;
+}
+
+#if defined(RXCW_CRC32C_SSE42)
+__attribute__((target("sse4.2")))
+static uint32_t	crc32cHardware(uint32_t crc, const uint8_t* data, size_t size)
+{
+#if defined(__x86_64__)
+	uint64_t	crc64 = crc;
+
+	for (; size >= 8; data += 8, size -= 8)
+	{
+		uint64_t	value;
+
+		std::memcpy(&value, data, sizeof(value));
+		crc64 = _mm_crc32_u64(crc64, value);
+	}
+	crc = static_cast<uint32_t>(crc64);
+#endif
+	for (; size; data++, size--)
+		crc = _mm_crc32_u8(crc, *data);
+	return crc;
+}
+
+static const bool	CRC32C_HARDWARE = __builtin_cpu_supports("sse4.2");
+#endif
+
+static uint64_t	rotateLeft(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static uint32_t	rotateRight(uint32_t value, int bits)
+{
+	return (value >> bits) | (value << (32 - bits));
+}
+
+static uint64_t	loadLittleEndian64(const uint8_t* data)
+{
+	uint64_t	value = 0;
+
+	for (int i = 7; i >= 0; i--)
+		value = (value << 8) | data[i];
+	return value;
+}
+
+static uint32_t	loadLittleEndian32(const uint8_t* data)
+{
+	return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 | static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+static uint64_t	xxHash64Round(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * XXH_PRIME64_2;
+	return rotateLeft(accumulator, 31) * XXH_PRIME64_1;
+}
+
+static uint64_t	xxHash64Merge(uint64_t accumulator, uint64_t value)
+{
+	accumulator ^= xxHash64Round(0, value);
+	return accumulator * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+static void		sha256Transform(uint64_t* state, const uint8_t* block)
+{
+	uint32_t	w[64];
+	uint32_t	h[8];
+
+	for (int i = 0; i < 16; i++)
+		w[i] = static_cast<uint32_t>(block[i * 4]) << 24 | static_cast<uint32_t>(block[i * 4 + 1]) << 16 | static_cast<uint32_t>(block[i * 4 + 2]) << 8 | block[i * 4 + 3];
+	for (int i = 16; i < 64; i++)
+	{
+		uint32_t	s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		uint32_t	s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+	for (int i = 0; i < 8; i++)
+		h[i] = static_cast<uint32_t>(state[i]);
+	for (int i = 0; i < 64; i++)
+	{
+		uint32_t	s1 = rotateRight(h[4], 6) ^ rotateRight(h[4], 11) ^ rotateRight(h[4], 25);
+		uint32_t	choice = (h[4] & h[5]) ^ (~h[4] & h[6]);
+		uint32_t	t1 = h[7] + s1 + choice + SHA256_K[i] + w[i];
+		uint32_t	s0 = rotateRight(h[0], 2) ^ rotateRight(h[0], 13) ^ rotateRight(h[0], 22);
+		uint32_t	majority = (h[0] & h[1]) ^ (h[0] & h[2]) ^ (h[1] & h[2]);
+
+		h[7] = h[6];
+		h[6] = h[5];
+		h[5] = h[4];
+		h[4] = h[3] + t1;
+		h[3] = h[2];
+		h[2] = h[1];
+		h[1] = h[0];
+		h[0] = t1 + s0 + majority;
+	}
+	for (int i = 0; i < 8; i++)
+		state[i] = static_cast<uint32_t>(state[i] + h[i]);
+}
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+Checksum::Checksum(Algorithm algorithm)
+	: _algorithm(algorithm)
+	, _crc(0xFFFFFFFF)
+	, _blockSize(0)
+	, _total(0)
+{
+	static const uint64_t	SHA256_INITIAL_STATE[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+
+	if (_algorithm == Algorithm::SHA256)
+		std::memcpy(_state, SHA256_INITIAL_STATE, sizeof(_state));
+	else
+	{
+		_state[0] = XXH_PRIME64_1 + XXH_PRIME64_2;
+		_state[1] = XXH_PRIME64_2;
+		_state[2] = 0;
+		_state[3] = 0 - XXH_PRIME64_1;
+	}
+}
+
+Checksum::~Checksum(void)
+{
+}
+
+void				Checksum::update(const char* data, size_t size)
+{
+	const uint8_t*	bytes = reinterpret_cast<const uint8_t*>(data);
+
+	_total += size;
+	switch (_algorithm)
+	{
+		case Algorithm::CRC32C:
+#if defined(RXCW_CRC32C_SSE42)
+			if (CRC32C_HARDWARE)
+			{
+				_crc = crc32cHardware(_crc, bytes, size);
+				break;
+			}
+#endif
+			_crc = crc32cSoftware(_crc, bytes, size);
+			break;
+		case Algorithm::XXHASH64:
+			updateXxHash64(bytes, size);
+			break;
+		case Algorithm::SHA256:
+			updateSha256(bytes, size);
+			break;
+	}
+}
+
+void				Checksum::update(const Buffer& data)
+{
+	update(data.data(), data.size());
+}
+
+Checksum::Digest	Checksum::digest() const
+{
+	switch (_algorithm)
+	{
+		case Algorithm::XXHASH64:
+			return digestXxHash64();
+		case Algorithm::SHA256:
+			return digestSha256();
+		default:
+		{
+			uint32_t	crc = ~_crc;
+
+			return Digest({ static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc) });
+		}
+	}
+}
+
+Checksum::Algorithm	Checksum::algorithm() const
+{
+	return _algorithm;
+}
+
+std::string			Checksum::toHex(const Digest& digest)
+{
+	static const char	DIGITS[] = "0123456789abcdef";
+	std::string			result;
+
+	result.reserve(digest.size() * 2);
+	for (uint8_t byte : digest)
+	{
+		result.push_back(DIGITS[byte >> 4]);
+		result.push_back(DIGITS[byte & 0xF]);
+	}
+	return result;
+}
+
+void				Checksum::updateXxHash64(const uint8_t* data, size_t size)
+{
+	// stripes of 32 bytes, the remainder waits in the block
+	if (_blockSize)
+	{
+		size_t	missing = std::min(32 - _blockSize, size);
+
+		std::memcpy(_block + _blockSize, data, missing);
+		_blockSize += missing;
+		data += missing;
+		size -= missing;
+		if (_blockSize < 32)
+			return ;
+		for (int i = 0; i < 4; i++)
+			_state[i] = xxHash64Round(_state[i], loadLittleEndian64(_block + i * 8));
+		_blockSize = 0;
+	}
+	for (; size >= 32; data += 32, size -= 32)
+		for (int i = 0; i < 4; i++)
+			_state[i] = xxHash64Round(_state[i], loadLittleEndian64(data + i * 8));
+	std::memcpy(_block, data, size);
+	_blockSize = size;
+}
+
+void				Checksum::updateSha256(const uint8_t* data, size_t size)
+{
+	if (_blockSize)
+	{
+		size_t	missing = std::min(64 - _blockSize, size);
+
+		std::memcpy(_block + _blockSize, data, missing);
+		_blockSize += missing;
+		data += missing;
+		size -= missing;
+		if (_blockSize < 64)
+			return ;
+		sha256Transform(_state, _block);
+		_blockSize = 0;
+	}
+	for (; size >= 64; data += 64, size -= 64)
+		sha256Transform(_state, data);
+	std::memcpy(_block, data, size);
+	_blockSize = size;
+}
+
+Checksum::Digest	Checksum::digestXxHash64() const
+{
+	uint64_t	hash;
+
+	if (_total >= 32)
+	{
+		hash = rotateLeft(_state[0], 1) + rotateLeft(_state[1], 7) + rotateLeft(_state[2], 12) + rotateLeft(_state[3], 18);
+		for (int i = 0; i < 4; i++)
+			hash = xxHash64Merge(hash, _state[i]);
+	}
+	else
+		hash = XXH_PRIME64_5;
+	hash += _total;
+
+	const uint8_t*	data = _block;
+	size_t			size = _blockSize;
+
+	for (; size >= 8; data += 8, size -= 8)
+		hash = rotateLeft(hash ^ xxHash64Round(0, loadLittleEndian64(data)), 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+	if (size >= 4)
+	{
+		hash = rotateLeft(hash ^ (loadLittleEndian32(data) * XXH_PRIME64_1), 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		data += 4;
+		size -= 4;
+	}
+	for (; size; data++, size--)
+		hash = rotateLeft(hash ^ (*data * XXH_PRIME64_5), 11) * XXH_PRIME64_1;
+
+	hash ^= hash >> 33;
+	hash *= XXH_PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= XXH_PRIME64_3;
+	hash ^= hash >> 32;
+
+	Digest	result(8);
+
+	for (int i = 0; i < 8; i++)
+		result[i] = static_cast<uint8_t>(hash >> (56 - i * 8));
+	return result;
+}
+
+Checksum::Digest	Checksum::digestSha256() const
+{
+	uint64_t	state[8];
+	uint8_t		block[128] = {};
+	size_t		size = _blockSize < 56 ? 64 : 128;
+	uint64_t	bits = _total * 8;
+
+	// padding and length on a copy, so that more data can be added afterward
+	std::memcpy(state, _state, sizeof(state));
+	std::memcpy(block, _block, _blockSize);
+	block[_blockSize] = 0x80;
+	for (int i = 0; i < 8; i++)
+		block[size - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+	for (size_t offset = 0; offset < size; offset += 64)
+		sha256Transform(state, block + offset);
+
+	Digest	result(32);
+
+	for (int i = 0; i < 32; i++)
+		result[i] = static_cast<uint8_t>(state[i / 4] >> (24 - (i % 4) * 8));
+	return result;
+}
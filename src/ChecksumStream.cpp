@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: ChecksumStream.cpp
+ * Created: 16th October 2026 1:52:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 1:52:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/ChecksumStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+ChecksumStream::ChecksumStream(Checksum::Algorithm algorithm)
+	: _checksum(algorithm)
+	, _done(false)
+{
+}
+
+ChecksumStream::~ChecksumStream(void)
+{
+	std::exception_ptr	exception = std::make_exception_ptr(std::logic_error("stream destroyed before being ended"));
+
+	for (const DigestWaiter& waiter : _digestWaiters)
+		waiter.onError(exception);
+}
+
+Single<Checksum::Digest>	ChecksumStream::rxDigest()
+{
+	return Single<Checksum::Digest>::create([this](Single<Checksum::Digest>::SuccessFunction onSuccess, Single<Checksum::Digest>::ErrorFunction onError)
+	{
+		std::unique_lock<std::recursive_mutex>	lock(_mutex);
+
+		if (_done)
+		{
+			Checksum::Digest	digest = _digest;
+
+			lock.unlock();
+			onSuccess(digest);
+			return ;
+		}
+		if (_failure)
+		{
+			std::exception_ptr	exception = _failure;
+
+			lock.unlock();
+			onError(exception);
+			return ;
+		}
+		_digestWaiters.push_back({onSuccess, onError});
+	});
+}
+
+void			ChecksumStream::transform(const Buffer& data)
+{
+	_checksum.update(data);
+	push(data);
+}
+
+void			ChecksumStream::flush()
+{
+	std::vector<DigestWaiter>	waiters;
+	Checksum::Digest			digest = _checksum.digest();
+
+	_done = true;
+	_digest = digest;
+	waiters.swap(_digestWaiters);
+	defer([waiters, digest]()
+	{
+		for (const DigestWaiter& waiter : waiters)
+			waiter.onSuccess(digest);
+	});
+	finish();
+}
+
+void			ChecksumStream::failed(std::exception_ptr exception)
+{
+	std::vector<DigestWaiter>	waiters;
+
+	_failure = exception;
+	waiters.swap(_digestWaiters);
+	defer([waiters, exception]()
+	{
+		for (const DigestWaiter& waiter : waiters)
+			waiter.onError(exception);
+	});
+}
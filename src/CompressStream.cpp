@@ -0,0 +1,267 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: CompressStream.cpp
+ * Created: 16th October 2026 12:58:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:58:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#if defined(RXCW_ENABLE_ZLIB)
+
+#include "RxCW/CompressStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include "RxCW/BufferPool.h"
+#include "RxCW/IOScheduler.h"
+#include "RxCW/Single.h"
+
+// stl
+#include <stdexcept>
+
+// zlib
+#include <zlib.h>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+// 15 bits window, with a gzip header and trailer
+static const int	GZIP_WINDOW_BITS = 15 + 16;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+CompressStream::CompressStream(int level, size_t parallelism, size_t blockSize)
+	: _level(level)
+	, _parallelism(parallelism)
+	, _blockSize(blockSize)
+	, _blockFill(0)
+	, _nextBlock(0)
+	, _nextPush(0)
+	, _pending(0)
+	, _flushing(false)
+{
+	if (level < 0 || level > 9)
+		throw std::invalid_argument("level must be between 0 and 9");
+	if (!parallelism || !blockSize)
+		throw std::invalid_argument("parallelism and blockSize must be greater than 0");
+
+	// blocks compressed in parallel each use their own stream
+	if (_parallelism == 1)
+	{
+		_stream.reset(new z_stream());
+		if (deflateInit2(_stream.get(), _level, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			throw std::runtime_error("Can't initialize compression stream");
+	}
+}
+
+CompressStream::~CompressStream(void)
+{
+	revoke();
+	if (_stream)
+		deflateEnd(_stream.get());
+}
+
+void			CompressStream::transform(const Buffer& data)
+{
+	if (_stream)
+	{
+		compressStream(data, Z_NO_FLUSH);
+		return ;
+	}
+
+	_block.push_back(data);
+	_blockFill += data.size();
+	if (_blockFill >= _blockSize)
+		compressBlock();
+}
+
+void			CompressStream::flush()
+{
+	if (_stream)
+	{
+		compressStream(Buffer(), Z_FINISH);
+		finish();
+		return ;
+	}
+
+	_flushing = true;
+	compressBlock();
+	if (!_pending)
+		finish();
+}
+
+bool			CompressStream::busy()
+{
+	return _pending >= _parallelism;
+}
+
+void			CompressStream::compressStream(const Buffer& data, int flush)
+{
+	_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+	_stream->avail_in = static_cast<uInt>(data.size());
+
+	// deflate keeps data for itself until its output buffer is not filled anymore
+	do
+	{
+		Buffer	output = BufferPool::acquire(OUTPUT_CHUNK_SIZE);
+
+		_stream->next_out = reinterpret_cast<Bytef*>(output.data());
+		_stream->avail_out = static_cast<uInt>(output.size());
+		if (deflate(_stream.get(), flush) == Z_STREAM_ERROR)
+		{
+			fail(std::make_exception_ptr(std::runtime_error("Error while compressing data")));
+			return ;
+		}
+		push(output.slice(0, output.size() - _stream->avail_out));
+	}
+	while (!_stream->avail_out);
+}
+
+void			CompressStream::compressBlock()
+{
+	if (!_blockFill)
+		return ;
+
+	uint64_t			index = _nextBlock++;
+	std::vector<Buffer>	parts;
+	size_t				size = _blockFill;
+	int					level = _level;
+
+	parts.swap(_block);
+	_blockFill = 0;
+	_pending++;
+	std::shared_ptr<Token>	token = _token;
+
+	// deflate runs on the compute pool, the blocks come back through the token as the stream may be destroyed meanwhile
+	Single<Buffer>::create([parts, size, level](Single<Buffer>::SuccessFunction onSuccess, Single<Buffer>::ErrorFunction onError)
+		{
+			try
+			{
+				onSuccess(compress(parts, size, level));
+			}
+			catch (const std::exception&)
+			{
+				onError(std::current_exception());
+			}
+		})
+		.subscribeOn(rxcpp::synchronize_in_one_worker(IOScheduler::computeScheduler()))
+		.subscribe(
+			[this, token, index](Buffer data)
+			{
+				Pin	pin(token);
+
+				if (pin)
+					blockCompressed(index, data);
+			},
+			[this, token](std::exception_ptr exception)
+			{
+				Pin	pin(token);
+
+				if (!pin)
+					return ;
+				{
+					std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+					_pending--;
+					fail(exception);
+				}
+				deliver();
+			});
+}
+
+void			CompressStream::blockCompressed(uint64_t index, const Buffer& data)
+{
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		_pending--;
+		_compressed[index] = data;
+		// blocks are pushed in order, whatever order they were compressed in
+		for (auto it = _compressed.find(_nextPush); it != _compressed.end(); it = _compressed.find(_nextPush))
+		{
+			Buffer	block = it->second;
+
+			_compressed.erase(it);
+			_nextPush++;
+			push(block);
+		}
+		drained();
+		if (_flushing && !_pending)
+			finish();
+	}
+	deliver();
+}
+
+Buffer			CompressStream::compress(const std::vector<Buffer>& parts, size_t size, int level)
+{
+	z_stream	stream = z_stream();
+
+	if (deflateInit2(&stream, level, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		throw std::runtime_error("Can't initialize compression stream");
+
+	// the bound guarantees a single pass
+	Buffer	output = BufferPool::acquire(deflateBound(&stream, static_cast<uLong>(size)));
+
+	stream.next_out = reinterpret_cast<Bytef*>(output.data());
+	stream.avail_out = static_cast<uInt>(output.size());
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(parts[i].data()));
+		stream.avail_in = static_cast<uInt>(parts[i].size());
+		if (deflate(&stream, i + 1 < parts.size() ? Z_NO_FLUSH : Z_FINISH) == Z_STREAM_ERROR)
+		{
+			deflateEnd(&stream);
+			throw std::runtime_error("Error while compressing data");
+		}
+	}
+
+	size_t	compressed = static_cast<size_t>(stream.total_out);
+
+	deflateEnd(&stream);
+	return output.slice(0, compressed);
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: DecompressStream.cpp
+ * Created: 16th October 2026 12:58:40 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:58:40 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#if defined(RXCW_ENABLE_ZLIB)
+
+#include "RxCW/DecompressStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include "RxCW/BufferPool.h"
+
+// stl
+#include <stdexcept>
+
+// zlib
+#include <zlib.h>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+// 15 bits window, detecting a gzip or zlib header
+static const int	AUTO_WINDOW_BITS = 15 + 32;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+DecompressStream::DecompressStream(void)
+	: _stream(new z_stream())
+	, _started(false)
+	, _memberEnded(false)
+{
+	if (inflateInit2(_stream.get(), AUTO_WINDOW_BITS) != Z_OK)
+		throw std::runtime_error("Can't initialize decompression stream");
+}
+
+DecompressStream::~DecompressStream(void)
+{
+	inflateEnd(_stream.get());
+}
+
+void			DecompressStream::transform(const Buffer& data)
+{
+	if (data.empty())
+		return ;
+
+	_started = true;
+	_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+	_stream->avail_in = static_cast<uInt>(data.size());
+
+	while (true)
+	{
+		Buffer	output = BufferPool::acquire(OUTPUT_CHUNK_SIZE);
+
+		_stream->next_out = reinterpret_cast<Bytef*>(output.data());
+		_stream->avail_out = static_cast<uInt>(output.size());
+
+		int	result = inflate(_stream.get(), Z_NO_FLUSH);
+
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+		{
+			fail(std::make_exception_ptr(std::runtime_error(std::string("Error while decompressing data: ") + (_stream->msg ? _stream->msg : "invalid data"))));
+			return ;
+		}
+		push(output.slice(0, output.size() - _stream->avail_out));
+
+		_memberEnded = result == Z_STREAM_END;
+		// another gzip member follows
+		if (_memberEnded && _stream->avail_in)
+		{
+			inflateReset(_stream.get());
+			continue;
+		}
+		// all the input is consumed and inflate has nothing more to output
+		if (_memberEnded || result == Z_BUF_ERROR || (!_stream->avail_in && _stream->avail_out))
+			break;
+	}
+}
+
+void			DecompressStream::flush()
+{
+	if (_started && !_memberEnded)
+	{
+		fail(std::make_exception_ptr(std::runtime_error("Compressed data is truncated")));
+		return ;
+	}
+	finish();
+}
+
+#endif
@@ -39,10 +39,45 @@
 
 // RxCW
 #include "RxCW/AsyncFile.h"
+#include "RxCW/BufferPool.h"
+#if defined(__linux__)
+#include "RxCW/FileWatcher.h"
+#endif
+#include "RxCW/IOScheduler.h"
+#if defined(RXCW_ENABLE_IO_URING)
+#include "RxCW/IOUring.h"
+#endif
 #include "RxCW/Single.h"
 
 // stl
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+// posix
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#include <unistd.h>
+#endif
 
 /*
 ****************
@@ -52,6 +87,1017 @@
 
 using namespace RxCW;
 
+/*
+************
+** static **
+************
+*/
+
+std::mutex								FileSystem::_mutex;
+std::optional<FileSystem::Schedulers>	FileSystem::_schedulers;
+
+std::mutex											FileSystem::_metadataMutex;
+std::chrono::milliseconds							FileSystem::_metadataTtl(0);
+size_t												FileSystem::_metadataCacheSize = FileSystem::DEFAULT_METADATA_CACHE_SIZE;
+std::map<std::string, FileSystem::CachedStat>		FileSystem::_metadata;
+std::list<std::string>								FileSystem::_recent;
+uint64_t											FileSystem::_metadataGeneration = 0;
+
+// runs the subscription on the io scheduler, and observes the result on the result scheduler if any
+template	<typename T>
+static T	dispatch(T reactive, const FileSystem::Schedulers& schedulers)
+{
+	T	subscribed = reactive.subscribeOn(rxcpp::synchronize_in_one_worker(schedulers.io));
+
+	if (schedulers.result)
+		return subscribed.observeOn(rxcpp::observe_on_one_worker(*schedulers.result));
+	return subscribed;
+}
+
+#if defined(__linux__)
+namespace
+{
+	// the record returned by getdents64, not declared by every libc
+	struct	LinuxDirent64
+	{
+		uint64_t		d_ino;
+		int64_t			d_off;
+		unsigned short	d_reclen;
+		unsigned char	d_type;
+		char			d_name[1];
+	};
+
+	// an open directory being read
+	struct	WalkedDirectory
+	{
+		WalkedDirectory(int fd, const std::string& path, size_t depth, size_t bufferSize)
+			: fd(fd)
+			, path(path)
+			, depth(depth)
+			, buffer(new char[bufferSize])
+			, size(0)
+			, offset(0)
+		{
+		}
+
+		~WalkedDirectory(void)
+		{
+			close(fd);
+		}
+
+		int						fd;
+		std::string				path;
+		size_t					depth;
+		std::unique_ptr<char[]>	buffer;
+		long					size;
+		long					offset;
+	};
+}
+
+static FileSystem::DirEntry::Type	entryType(mode_t mode)
+{
+	if (S_ISREG(mode))
+		return FileSystem::DirEntry::Type::FILE;
+	if (S_ISDIR(mode))
+		return FileSystem::DirEntry::Type::DIRECTORY;
+	if (S_ISLNK(mode))
+		return FileSystem::DirEntry::Type::SYMLINK;
+	return FileSystem::DirEntry::Type::OTHER;
+}
+
+static void	walk(const std::string& root, const FileSystem::WalkOptions& options, const Observable<FileSystem::DirEntry>::SuccessFunction& onNext, const Observable<FileSystem::DirEntry>::SubscribedFunction& subscribed)
+{
+	std::vector<std::unique_ptr<WalkedDirectory>>	stack;
+	int												fd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if (fd < 0)
+		throw std::system_error(errno, std::generic_category(), "Can't open directory " + root);
+	stack.emplace_back(new WalkedDirectory(fd, root.size() > 1 && root.back() == '/' ? root.substr(0, root.size() - 1) : root, 0, options.bufferSize));
+
+	// stops once the subscriber is gone, the directories are closed by the stack
+	while (!stack.empty() && subscribed())
+	{
+		WalkedDirectory&	directory = *stack.back();
+
+		if (directory.offset >= directory.size)
+		{
+			directory.size = syscall(SYS_getdents64, directory.fd, directory.buffer.get(), options.bufferSize);
+			directory.offset = 0;
+			if (directory.size < 0 && !options.ignoreErrors)
+				throw std::system_error(errno, std::generic_category(), "Can't read directory " + directory.path);
+			if (directory.size <= 0)
+				stack.pop_back();
+			continue;
+		}
+
+		const LinuxDirent64*	record = reinterpret_cast<const LinuxDirent64*>(directory.buffer.get() + directory.offset);
+		FileSystem::DirEntry	entry;
+
+		directory.offset += record->d_reclen;
+		if (!std::strcmp(record->d_name, ".") || !std::strcmp(record->d_name, ".."))
+			continue;
+		entry.name = record->d_name;
+		entry.path = (directory.path == "/" ? "" : directory.path) + "/" + entry.name;
+		entry.depth = directory.depth + 1;
+		entry.inode = record->d_ino;
+		switch (record->d_type)
+		{
+			case DT_REG:
+				entry.type = FileSystem::DirEntry::Type::FILE;
+				break;
+			case DT_DIR:
+				entry.type = FileSystem::DirEntry::Type::DIRECTORY;
+				break;
+			case DT_LNK:
+				entry.type = FileSystem::DirEntry::Type::SYMLINK;
+				break;
+			case DT_UNKNOWN:
+			{
+				// only some file systems leave the type unknown
+				struct stat	status;
+
+				entry.type = fstatat(directory.fd, record->d_name, &status, AT_SYMLINK_NOFOLLOW) ? FileSystem::DirEntry::Type::OTHER : entryType(status.st_mode);
+				break;
+			}
+			default:
+				entry.type = FileSystem::DirEntry::Type::OTHER;
+				break;
+		}
+
+		if (!options.filter || options.filter(entry))
+			onNext(entry);
+		if (entry.type != FileSystem::DirEntry::Type::DIRECTORY || entry.depth >= options.maxDepth || (options.descend && !options.descend(entry)))
+			continue;
+
+		int	child = openat(directory.fd, record->d_name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+		if (child < 0)
+		{
+			if (options.ignoreErrors)
+				continue;
+			throw std::system_error(errno, std::generic_category(), "Can't open directory " + entry.path);
+		}
+		stack.emplace_back(new WalkedDirectory(child, entry.path, entry.depth, options.bufferSize));
+	}
+}
+#else
+static void	walk(const std::string& root, const FileSystem::WalkOptions& options, const Observable<FileSystem::DirEntry>::SuccessFunction& onNext, const Observable<FileSystem::DirEntry>::SubscribedFunction& subscribed)
+{
+	std::vector<std::pair<std::filesystem::directory_iterator, size_t>>	stack;
+
+	stack.emplace_back(std::filesystem::directory_iterator(root), 0);
+	while (!stack.empty() && subscribed())
+	{
+		std::filesystem::directory_iterator&	it = stack.back().first;
+		size_t									depth = stack.back().second;
+
+		if (it == std::filesystem::directory_iterator())
+		{
+			stack.pop_back();
+			continue;
+		}
+
+		std::filesystem::file_status	status = it->symlink_status();
+		FileSystem::DirEntry			entry;
+
+		entry.path = it->path().string();
+		entry.name = it->path().filename().string();
+		entry.depth = depth + 1;
+		entry.inode = 0;
+		if (std::filesystem::is_regular_file(status))
+			entry.type = FileSystem::DirEntry::Type::FILE;
+		else if (std::filesystem::is_directory(status))
+			entry.type = FileSystem::DirEntry::Type::DIRECTORY;
+		else if (std::filesystem::is_symlink(status))
+			entry.type = FileSystem::DirEntry::Type::SYMLINK;
+		else
+			entry.type = FileSystem::DirEntry::Type::OTHER;
+		++it;
+
+		if (!options.filter || options.filter(entry))
+			onNext(entry);
+		if (entry.type != FileSystem::DirEntry::Type::DIRECTORY || entry.depth >= options.maxDepth || (options.descend && !options.descend(entry)))
+			continue;
+
+		std::error_code						error;
+		std::filesystem::directory_iterator	child(entry.path, error);
+
+		if (error)
+		{
+			if (options.ignoreErrors)
+				continue;
+			throw std::filesystem::filesystem_error("Can't open directory", entry.path, error);
+		}
+		stack.emplace_back(std::move(child), entry.depth);
+	}
+}
+#endif
+
+#if defined(__linux__)
+// the statx fields StatResult is made of
+static const unsigned int	STAT_MASK = STATX_TYPE | STATX_MODE | STATX_INO | STATX_SIZE | STATX_MTIME;
+
+static FileSystem::StatResult	statResult(const std::string& path, int error, const struct statx* status)
+{
+	FileSystem::StatResult	result = FileSystem::StatResult();
+
+	result.path = path;
+	result.exists = !error;
+	result.error = error;
+	result.type = FileSystem::DirEntry::Type::OTHER;
+	if (error)
+		return result;
+	result.type = entryType(status->stx_mode);
+	result.size = status->stx_size;
+	result.mode = status->stx_mode & 07777;
+	result.inode = status->stx_ino;
+	result.modified = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::seconds(status->stx_mtime.tv_sec) + std::chrono::nanoseconds(status->stx_mtime.tv_nsec)));
+	return result;
+}
+
+static FileSystem::StatResult	statPath(const std::string& path)
+{
+	struct statx	status;
+
+	if (statx(AT_FDCWD, path.c_str(), AT_STATX_SYNC_AS_STAT, STAT_MASK, &status))
+		return statResult(path, errno, nullptr);
+	return statResult(path, 0, &status);
+}
+#else
+static FileSystem::StatResult	statPath(const std::string& path)
+{
+	FileSystem::StatResult				result = FileSystem::StatResult();
+	std::error_code						error;
+	std::filesystem::file_status		status = std::filesystem::status(path, error);
+
+	result.path = path;
+	result.type = FileSystem::DirEntry::Type::OTHER;
+	if (!error && !std::filesystem::exists(status))
+		error = std::make_error_code(std::errc::no_such_file_or_directory);
+	if (error)
+	{
+		result.error = error.value();
+		return result;
+	}
+	result.exists = true;
+	if (std::filesystem::is_regular_file(status))
+	{
+		result.type = FileSystem::DirEntry::Type::FILE;
+		result.size = std::filesystem::file_size(path, error);
+	}
+	else if (std::filesystem::is_directory(status))
+		result.type = FileSystem::DirEntry::Type::DIRECTORY;
+	result.mode = static_cast<uint32_t>(status.permissions()) & 07777;
+
+	std::filesystem::file_time_type	modified = std::filesystem::last_write_time(path, error);
+
+	// file_time_type has no portable conversion in c++17
+	if (!error)
+		result.modified = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(modified - std::filesystem::file_time_type::clock::now());
+	return result;
+}
+#endif
+
+#if defined(__linux__) && defined(RXCW_ENABLE_IO_URING)
+// the number of paths stated with a single submission, under the ring queue depth
+static const size_t	STAT_BATCH_SIZE = IOUring::DEFAULT_QUEUE_DEPTH / 2;
+
+// set once the kernel rejects IORING_OP_STATX, added in Linux 5.6
+static std::atomic<bool>	ringStatUnsupported(false);
+
+namespace
+{
+	// a batch of statx requests, shared with the ring completion thread
+	struct	StatBatch
+	{
+		std::mutex					mutex;
+		std::condition_variable		done;
+		size_t						remaining;
+		std::vector<std::string>	paths;
+		std::vector<struct statx>	statuses;
+		std::vector<int>			errors;
+	};
+}
+
+// stats the paths through io_uring, returns false if it is not available
+static bool	statBatches(const std::vector<std::string>& paths, const std::function<void(const FileSystem::StatResult&)>& onResult)
+{
+	IOUring*	ring = IOUring::get();
+
+	if (!ring || ringStatUnsupported)
+		return false;
+
+	for (size_t first = 0; first < paths.size(); first += STAT_BATCH_SIZE)
+	{
+		std::shared_ptr<StatBatch>			batch = std::make_shared<StatBatch>();
+		size_t								count = std::min(STAT_BATCH_SIZE, paths.size() - first);
+		std::vector<IOUring::StatRequest>	requests(count);
+
+		batch->remaining = count;
+		batch->paths.assign(paths.begin() + first, paths.begin() + first + count);
+		batch->statuses.resize(count);
+		batch->errors.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			requests[i].dirfd = AT_FDCWD;
+			requests[i].path = batch->paths[i].c_str();
+			requests[i].flags = AT_STATX_SYNC_AS_STAT;
+			requests[i].mask = STAT_MASK;
+			requests[i].buffer = &batch->statuses[i];
+			requests[i].onComplete = [batch, i](ssize_t result)
+			{
+				std::lock_guard<std::mutex>	lock(batch->mutex);
+
+				batch->errors[i] = result < 0 ? static_cast<int>(-result) : 0;
+				if (!--batch->remaining)
+					batch->done.notify_all();
+			};
+		}
+		ring->stat(requests);
+
+		// results are emitted from the subscribing thread, in order, rather than from the ring completion thread
+		{
+			std::unique_lock<std::mutex>	lock(batch->mutex);
+
+			batch->done.wait(lock, [&batch]()
+			{
+				return !batch->remaining;
+			});
+		}
+		for (size_t i = 0; i < count; i++)
+		{
+			// older kernels fail every unknown opcode with EINVAL, which statx itself never returns for these flags
+			if (batch->errors[i] == EINVAL)
+			{
+				ringStatUnsupported = true;
+				onResult(statPath(batch->paths[i]));
+			}
+			else
+				onResult(statResult(batch->paths[i], batch->errors[i], &batch->statuses[i]));
+		}
+	}
+	return true;
+}
+#endif
+
+#if !defined(_WIN32)
+// the minimum time between two progress reports
+static const std::chrono::milliseconds	PROGRESS_INTERVAL(100);
+// the number of files of a directory a single task removes or copies
+static const size_t						TREE_BATCH_SIZE = 1024;
+// the size of the buffer files are copied with when the kernel can't copy them
+static const size_t						COPY_BUFFER_SIZE = 1024 * 1024;
+
+namespace
+{
+	struct	TreeJob;
+
+	// the job and the worker running the current task on this thread, so that the tasks it adds stay local
+	thread_local TreeJob*	currentJob = nullptr;
+	thread_local size_t		currentWorker = 0;
+
+	// runs the tasks of a recursive operation on the blocking calls pool, and reports its progress
+	struct	TreeJob : public std::enable_shared_from_this<TreeJob>
+	{
+		// a deque per worker, the tasks a worker adds are pushed to its own one
+		struct	Worker
+		{
+			std::mutex							mutex;
+			std::deque<std::function<void()>>	tasks;
+		};
+
+		explicit TreeJob(size_t parallelism)
+			: workers(parallelism)
+		{
+			// the last worker is woken first, and steals from the first one
+			for (size_t i = 0; i < parallelism; i++)
+			{
+				workers[i].reset(new Worker());
+				idle.push_back(i);
+			}
+		}
+
+		Observable<FileSystem::Progress>::SuccessFunction		onNext;
+		Observable<FileSystem::Progress>::CompleteFunction		onComplete;
+		Observable<FileSystem::Progress>::ErrorFunction			onError;
+
+		std::vector<std::unique_ptr<Worker>>	workers;
+		// guards the fields below, the deques have their own mutex
+		std::mutex								mutex;
+		// the workers not scheduled on the pool
+		std::vector<size_t>						idle;
+		// tasks added but not taken yet, a worker doesn't go idle while some are about to be pushed
+		size_t									queued = 0;
+		// tasks queued or running, the job is done once it falls to 0
+		size_t									outstanding = 0;
+		std::atomic<bool>						terminated{false};
+
+		std::atomic<uint64_t>					files{0};
+		std::atomic<uint64_t>					directories{0};
+		std::atomic<uint64_t>					bytes{0};
+		// serializes the notifications, and keeps them from following an error
+		std::mutex								reportMutex;
+		std::chrono::steady_clock::time_point	reported;
+		bool									failed = false;
+
+		void	add(const std::function<void()>& task)
+		{
+			// the tasks added from outside the job go to the first worker
+			size_t	index = currentJob == this ? currentWorker : 0;
+
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				if (terminated)
+					return ;
+				queued++;
+				outstanding++;
+			}
+			{
+				std::lock_guard<std::mutex>	lock(workers[index]->mutex);
+
+				workers[index]->tasks.push_back(task);
+				// cancel may have cleared the deques before the push
+				if (terminated)
+					workers[index]->tasks.clear();
+			}
+			wake();
+		}
+
+		void	wake()
+		{
+			size_t	index;
+
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				if (idle.empty() || terminated)
+					return ;
+				index = idle.back();
+				idle.pop_back();
+			}
+			schedule(index);
+		}
+
+		void	schedule(size_t index)
+		{
+			std::shared_ptr<TreeJob>	self = shared_from_this();
+
+			Completable::create([self, index](Completable::CompleteFunction onComplete, Completable::ErrorFunction)
+				{
+					self->run(index);
+					onComplete();
+				})
+				.subscribeOn(rxcpp::synchronize_in_one_worker(IOScheduler::blockingScheduler()))
+				.subscribe();
+		}
+
+		bool	take(size_t index, std::function<void()>& task)
+		{
+			{
+				Worker&						worker = *workers[index];
+				std::lock_guard<std::mutex>	lock(worker.mutex);
+
+				// its own last task first, the tree is walked depth first to bound the open directories
+				if (!worker.tasks.empty())
+				{
+					task = std::move(worker.tasks.back());
+					worker.tasks.pop_back();
+					return true;
+				}
+			}
+			// then the oldest task of another worker, the closest to the root and so the biggest subtree
+			for (size_t i = 1; i < workers.size(); i++)
+			{
+				Worker&						victim = *workers[(index + i) % workers.size()];
+				std::lock_guard<std::mutex>	lock(victim.mutex);
+
+				if (!victim.tasks.empty())
+				{
+					task = std::move(victim.tasks.front());
+					victim.tasks.pop_front();
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void	run(size_t index)
+		{
+			std::function<void()>	task;
+
+			if (terminated || !take(index, task))
+			{
+				std::unique_lock<std::mutex>	lock(mutex);
+
+				// a task counted but not pushed yet is taken on the next schedule
+				if (queued && !terminated)
+				{
+					lock.unlock();
+					schedule(index);
+					return ;
+				}
+				idle.push_back(index);
+				return ;
+			}
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				queued--;
+			}
+
+			TreeJob*	previousJob = currentJob;
+			size_t		previousWorker = currentWorker;
+
+			currentJob = this;
+			currentWorker = index;
+			try
+			{
+				task();
+				report(false);
+			}
+			catch (const std::exception&)
+			{
+				fail(std::current_exception());
+			}
+			currentJob = previousJob;
+			currentWorker = previousWorker;
+			task = nullptr;
+
+			{
+				std::unique_lock<std::mutex>	lock(mutex);
+
+				outstanding--;
+				if (!terminated && !outstanding)
+				{
+					terminated = true;
+					lock.unlock();
+					report(true);
+					onComplete();
+					return ;
+				}
+			}
+			// a single task per schedule, so that the pool thread is given back to the other blocking calls in between
+			schedule(index);
+		}
+
+		void	report(bool last)
+		{
+			std::lock_guard<std::mutex>				lock(reportMutex);
+			std::chrono::steady_clock::time_point	now = std::chrono::steady_clock::now();
+
+			if (failed || (!last && now - reported < PROGRESS_INTERVAL))
+				return ;
+			reported = now;
+			onNext(FileSystem::Progress{ files, directories, bytes });
+		}
+
+		void	clear()
+		{
+			for (const std::unique_ptr<Worker>& worker : workers)
+			{
+				std::lock_guard<std::mutex>	lock(worker->mutex);
+
+				worker->tasks.clear();
+			}
+		}
+
+		void	cancel()
+		{
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				// the running tasks complete, but nothing more is started or reported
+				terminated = true;
+			}
+			clear();
+		}
+
+		void	fail(std::exception_ptr exception)
+		{
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				if (terminated)
+					return ;
+				terminated = true;
+			}
+			clear();
+
+			std::lock_guard<std::mutex>	lock(reportMutex);
+
+			failed = true;
+			onError(exception);
+		}
+	};
+
+	// a directory being removed, once all its content is
+	struct	RemovedDirectory
+	{
+		~RemovedDirectory(void)
+		{
+			if (fd >= 0)
+				close(fd);
+		}
+
+		// the root is reached by its path, the others by their name from their parent, the path only shows in errors
+		std::string							path;
+		std::string							name;
+		std::shared_ptr<RemovedDirectory>	parent;
+		int									fd = -1;
+		std::atomic<size_t>					pending{1};
+	};
+
+	// a directory being copied, its content is copied relative to both of its descriptors
+	struct	CopiedDirectory
+	{
+		~CopiedDirectory(void)
+		{
+			if (sourceFd >= 0)
+				close(sourceFd);
+			if (destinationFd >= 0)
+				close(destinationFd);
+		}
+
+		std::string	source;
+		std::string	destination;
+		int			sourceFd = -1;
+		int			destinationFd = -1;
+	};
+}
+
+static int	openDirectory(int parent, const std::string& name, const std::string& path)
+{
+	int	fd = openat(parent, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+
+	if (fd < 0)
+		throw std::system_error(errno, std::generic_category(), "Can't open directory " + path);
+	return fd;
+}
+
+// opens a stream listing the given directory, which keeps its own descriptor
+static DIR*	listDirectory(int fd, const std::string& path)
+{
+	int		copy = dup(fd);
+	DIR*	stream = copy < 0 ? nullptr : fdopendir(copy);
+
+	if (!stream)
+	{
+		int	error = errno;
+
+		if (copy >= 0)
+			close(copy);
+		throw std::system_error(error, std::generic_category(), "Can't read directory " + path);
+	}
+	return stream;
+}
+
+static bool	isDirectory(int parent, const struct dirent* entry)
+{
+	struct stat	status;
+
+	if (entry->d_type != DT_UNKNOWN)
+		return entry->d_type == DT_DIR;
+	return !fstatat(parent, entry->d_name, &status, AT_SYMLINK_NOFOLLOW) && S_ISDIR(status.st_mode);
+}
+
+static void	releaseDirectory(const std::shared_ptr<TreeJob>& job, std::shared_ptr<RemovedDirectory> directory)
+{
+	// the last task done with a directory removes it from its parent, then releases the parent
+	while (directory && !--directory->pending)
+	{
+		int	parent = directory->parent ? directory->parent->fd : AT_FDCWD;
+
+		close(directory->fd);
+		directory->fd = -1;
+		if (unlinkat(parent, directory->parent ? directory->name.c_str() : directory->path.c_str(), AT_REMOVEDIR) && errno != ENOENT)
+			throw std::system_error(errno, std::generic_category(), "Can't remove directory " + directory->path);
+		job->directories++;
+		directory = directory->parent;
+	}
+}
+
+static void	removeFiles(const std::shared_ptr<TreeJob>& job, const std::shared_ptr<RemovedDirectory>& directory, const std::vector<std::string>& names)
+{
+	for (const std::string& name : names)
+	{
+		if (unlinkat(directory->fd, name.c_str(), 0) && errno != ENOENT)
+			throw std::system_error(errno, std::generic_category(), "Can't remove file " + directory->path + "/" + name);
+		job->files++;
+	}
+	releaseDirectory(job, directory);
+}
+
+static void	removeDirectory(const std::shared_ptr<TreeJob>& job, const std::shared_ptr<RemovedDirectory>& directory)
+{
+	std::vector<std::string>	names;
+	DIR*						stream;
+
+	// the descriptor stays open until the directory is removed, its content is removed relative to it
+	if (directory->parent)
+		directory->fd = openDirectory(directory->parent->fd, directory->name, directory->path);
+	else
+		directory->fd = openDirectory(AT_FDCWD, directory->path, directory->path);
+	stream = listDirectory(directory->fd, directory->path);
+	// subdirectories and batches of files are left to other tasks, each of them holding the directory
+	for (struct dirent* entry = readdir(stream); entry; entry = readdir(stream))
+	{
+		if (!std::strcmp(entry->d_name, ".") || !std::strcmp(entry->d_name, ".."))
+			continue;
+		if (isDirectory(directory->fd, entry))
+		{
+			std::shared_ptr<RemovedDirectory>	child = std::make_shared<RemovedDirectory>();
+
+			child->path = directory->path + "/" + entry->d_name;
+			child->name = entry->d_name;
+			child->parent = directory;
+			directory->pending++;
+			job->add([job, child]()
+			{
+				removeDirectory(job, child);
+			});
+			continue;
+		}
+		names.push_back(entry->d_name);
+		if (names.size() == TREE_BATCH_SIZE)
+		{
+			directory->pending++;
+			job->add([job, directory, names]()
+			{
+				removeFiles(job, directory, names);
+			});
+			names.clear();
+		}
+	}
+	closedir(stream);
+	removeFiles(job, directory, names);
+}
+
+static void	copyFile(const std::shared_ptr<TreeJob>& job, int sourceParent, const std::string& source, int destinationParent, const std::string& destination)
+{
+	struct stat	status;
+	int			input = openat(sourceParent, source.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+
+	if (input < 0)
+		throw std::system_error(errno, std::generic_category(), "Can't open file " + source);
+	if (fstat(input, &status))
+	{
+		int	error = errno;
+
+		close(input);
+		throw std::system_error(error, std::generic_category(), "Can't open file " + source);
+	}
+
+	int	output = openat(destinationParent, destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, status.st_mode & 07777);
+
+	if (output < 0)
+	{
+		int	error = errno;
+
+		close(input);
+		throw std::system_error(error, std::generic_category(), "Can't create file " + destination);
+	}
+
+	ssize_t	result = 0;
+	bool	kernel = true;
+	Buffer	buffer;
+
+	while (true)
+	{
+#if defined(__linux__)
+		if (kernel)
+		{
+			result = copy_file_range(input, nullptr, output, nullptr, COPY_BUFFER_SIZE, 0);
+			// not supported by these file systems, copy through user space instead
+			if (result < 0 && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP))
+			{
+				kernel = false;
+				continue;
+			}
+		}
+		else
+#endif
+		{
+			if (buffer.empty())
+				buffer = BufferPool::acquire(COPY_BUFFER_SIZE);
+			kernel = false;
+			result = read(input, buffer.data(), buffer.size());
+			// an interrupted write is retried, the chunk read is not read again
+			for (ssize_t written = 0, step; result > 0 && written < result; written += step)
+			{
+				step = write(output, buffer.data() + written, result - written);
+				if (step < 0 && errno == EINTR)
+					step = 0;
+				else if (step < 0)
+				{
+					result = -1;
+					break;
+				}
+			}
+		}
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			break;
+		job->bytes += result;
+	}
+
+	int	error = errno;
+
+	close(input);
+	if (close(output) && result >= 0)
+	{
+		error = errno;
+		result = -1;
+	}
+	if (result < 0)
+		throw std::system_error(error, std::generic_category(), "Can't copy file " + source);
+	job->files++;
+}
+
+static void	copyLink(const std::shared_ptr<TreeJob>& job, int sourceParent, const std::string& source, size_t size, int destinationParent, const std::string& destination)
+{
+	std::string	target(size + 1, '\0');
+	ssize_t		result = readlinkat(sourceParent, source.c_str(), &target[0], target.size());
+
+	if (result < 0)
+		throw std::system_error(errno, std::generic_category(), "Can't read link " + source);
+	target.resize(result);
+	// overwritten like files are
+	unlinkat(destinationParent, destination.c_str(), 0);
+	if (symlinkat(target.c_str(), destinationParent, destination.c_str()))
+		throw std::system_error(errno, std::generic_category(), "Can't create link " + destination);
+	job->files++;
+}
+
+static void	copyEntries(const std::shared_ptr<TreeJob>& job, const std::shared_ptr<CopiedDirectory>& directory, const std::vector<std::string>& names)
+{
+	for (const std::string& name : names)
+	{
+		struct stat	status;
+
+		if (fstatat(directory->sourceFd, name.c_str(), &status, AT_SYMLINK_NOFOLLOW))
+			throw std::system_error(errno, std::generic_category(), "Can't copy " + directory->source + "/" + name);
+		if (S_ISLNK(status.st_mode))
+			copyLink(job, directory->sourceFd, name, status.st_size, directory->destinationFd, name);
+		else if (S_ISREG(status.st_mode))
+			copyFile(job, directory->sourceFd, name, directory->destinationFd, name);
+	}
+}
+
+static void	copyDirectory(const std::shared_ptr<TreeJob>& job, const std::shared_ptr<CopiedDirectory>& parent, const std::string& source, const std::string& destination)
+{
+	std::shared_ptr<CopiedDirectory>	directory = std::make_shared<CopiedDirectory>();
+	int									sourceParent = parent ? parent->sourceFd : AT_FDCWD;
+	int									destinationParent = parent ? parent->destinationFd : AT_FDCWD;
+	struct stat							status;
+	DIR*								stream;
+	std::vector<std::string>			names;
+
+	// the children are reached from their parent descriptors, by name, the root from the given paths
+	directory->source = parent ? parent->source + "/" + source : source;
+	directory->destination = parent ? parent->destination + "/" + destination : destination;
+	directory->sourceFd = openDirectory(sourceParent, source, directory->source);
+	// the owner keeps the right to write into the copy, whatever the source permissions
+	if (fstat(directory->sourceFd, &status) || (mkdirat(destinationParent, destination.c_str(), (status.st_mode & 07777) | S_IRWXU) && errno != EEXIST))
+		throw std::system_error(errno, std::generic_category(), "Can't create directory " + directory->destination);
+	directory->destinationFd = openDirectory(destinationParent, destination, directory->destination);
+	stream = listDirectory(directory->sourceFd, directory->source);
+	for (struct dirent* entry = readdir(stream); entry; entry = readdir(stream))
+	{
+		if (!std::strcmp(entry->d_name, ".") || !std::strcmp(entry->d_name, ".."))
+			continue;
+		if (isDirectory(directory->sourceFd, entry))
+		{
+			std::string	name = entry->d_name;
+
+			job->add([job, directory, name]()
+			{
+				copyDirectory(job, directory, name, name);
+			});
+			continue;
+		}
+		names.push_back(entry->d_name);
+		if (names.size() == TREE_BATCH_SIZE)
+		{
+			job->add([job, directory, names]()
+			{
+				copyEntries(job, directory, names);
+			});
+			names.clear();
+		}
+	}
+	closedir(stream);
+	copyEntries(job, directory, names);
+	job->directories++;
+}
+#endif
+
+namespace
+{
+	// reads the chunks of a file in parallel, and emits them in order
+	struct	ChunkReader : public std::enable_shared_from_this<ChunkReader>
+	{
+		std::shared_ptr<AsyncFile>			file;
+		size_t								chunkSize;
+		size_t								parallelism;
+		Observable<Buffer>::SuccessFunction	onNext;
+		Observable<Buffer>::CompleteFunction	onComplete;
+		Observable<Buffer>::ErrorFunction		onError;
+
+		std::mutex							mutex;
+		uint64_t							nextRead = 0;
+		uint64_t							nextEmit = 0;
+		uint64_t							lastChunk = UINT64_MAX;
+		std::map<uint64_t, Buffer>			ready;
+		bool								emitting = false;
+		bool								terminated = false;
+
+		void	read()
+		{
+			std::shared_ptr<ChunkReader>	self = shared_from_this();
+			std::unique_lock<std::mutex>	lock(mutex);
+
+			// the window only moves forward once chunks are emitted
+			while (!terminated && nextRead <= lastChunk && nextRead < nextEmit + parallelism)
+			{
+				uint64_t	index = nextRead++;
+
+				lock.unlock();
+				file->rxReadAt(index * chunkSize, chunkSize)
+					.subscribe(
+						[self, index](Buffer chunk)
+						{
+							self->completed(index, chunk);
+						},
+						[self](std::exception_ptr exception)
+						{
+							self->failed(exception);
+						});
+				lock.lock();
+			}
+		}
+
+		void	completed(uint64_t index, const Buffer& chunk)
+		{
+			std::unique_lock<std::mutex>	lock(mutex);
+
+			// a short chunk is the last one, chunks read after it are empty
+			if (chunk.size() < chunkSize)
+				lastChunk = std::min(lastChunk, index);
+			if (index <= lastChunk)
+				ready[index] = chunk;
+
+			// a single thread emits at a time, the others leave their chunks to it
+			if (emitting || terminated)
+				return ;
+			emitting = true;
+			for (auto it = ready.find(nextEmit); !terminated && it != ready.end(); it = ready.find(nextEmit))
+			{
+				Buffer	next = it->second;
+
+				ready.erase(it);
+				nextEmit++;
+				lock.unlock();
+				if (!next.empty())
+					onNext(next);
+				lock.lock();
+			}
+			emitting = false;
+
+			if (!terminated && nextEmit > lastChunk)
+			{
+				terminated = true;
+				lock.unlock();
+				onComplete();
+				return ;
+			}
+			lock.unlock();
+			read();
+		}
+
+		void	cancel()
+		{
+			std::lock_guard<std::mutex>	lock(mutex);
+
+			// the reads in flight complete, but nothing more is read or emitted
+			terminated = true;
+		}
+
+		void	failed(std::exception_ptr exception)
+		{
+			{
+				std::lock_guard<std::mutex>	lock(mutex);
+
+				if (terminated)
+					return ;
+				terminated = true;
+			}
+			onError(exception);
+		}
+	};
+}
+
 /*
 ********************************************************************************
 ************************************ METHODS ***********************************
@@ -66,111 +1112,538 @@ FileSystem::~FileSystem(void)
 {
 }
 
+FileSystem::WalkOptions::WalkOptions(void)
+	: maxDepth(std::numeric_limits<size_t>::max())
+	, ignoreErrors(false)
+	, bufferSize(DEFAULT_WALK_BUFFER_SIZE)
+{
+}
+
+FileSystem::Schedulers::Schedulers(const rxcpp::schedulers::scheduler& io)
+	: io(io)
+{
+}
+
+FileSystem::Schedulers::Schedulers(const rxcpp::schedulers::scheduler& io, const rxcpp::schedulers::scheduler& result)
+	: io(io)
+	, result(result)
+{
+}
+
+void					FileSystem::setSchedulers(const Schedulers& schedulers)
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	_schedulers = schedulers;
+}
+
+void					FileSystem::resetSchedulers()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	_schedulers.reset();
+}
+
+FileSystem::Schedulers	FileSystem::schedulers()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	if (_schedulers)
+		return *_schedulers;
+	return Schedulers(IOScheduler::blockingScheduler());
+}
+
+void					FileSystem::setMetadataCache(std::chrono::milliseconds ttl, size_t maxEntries)
+{
+	if (!maxEntries)
+		throw std::invalid_argument("maxEntries must be greater than 0");
+
+	std::lock_guard<std::mutex>	lock(_metadataMutex);
+
+	_metadataTtl = ttl;
+	_metadataCacheSize = maxEntries;
+	_metadata.clear();
+	_recent.clear();
+	_metadataGeneration++;
+}
+
+void					FileSystem::invalidateMetadata(const std::string& path)
+{
+	std::lock_guard<std::mutex>	lock(_metadataMutex);
+
+	// a status being stated meanwhile may predate the change
+	_metadataGeneration++;
+	if (_metadata.empty())
+		return ;
+
+	auto	it = _metadata.find(path);
+
+	if (it != _metadata.end())
+		dropStat(it);
+
+	// the paths below it sort right after its trailing separator
+	std::string	prefix = (!path.empty() && path.back() == '/') ? path : path + '/';
+
+	for (it = _metadata.lower_bound(prefix); it != _metadata.end() && !it->first.compare(0, prefix.size(), prefix);)
+		it = dropStat(it);
+}
+
+void					FileSystem::clearMetadataCache()
+{
+	std::lock_guard<std::mutex>	lock(_metadataMutex);
+
+	_metadata.clear();
+	_recent.clear();
+	_metadataGeneration++;
+}
+
 AsyncFile*			FileSystem::open(const std::string& fileName, const std::string& mode)
 {
+	// any mode but reading may create or truncate the file
+	if (mode.find('r') == std::string::npos || mode.find('+') != std::string::npos)
+		invalidateMetadata(fileName);
 	return new AsyncFile(fileName, mode);
 }
 
-Single<AsyncFile*>	FileSystem::rxOpen(const std::string& fileName, const std::string& mode)
+Single<AsyncFile*>	FileSystem::rxOpen(const std::string& fileName, const std::string& mode, const Schedulers& schedulers)
 {
-	return Single<AsyncFile*>::defer([fileName, mode]()
+	return dispatch(Single<AsyncFile*>::defer([fileName, mode]()
 	{
 		return Single<AsyncFile*>::just(FileSystem::open(fileName, mode));
-	});
+	}), schedulers);
 }
 
 bool			FileSystem::exists(const std::string& path)
 {
-	return std::filesystem::exists(path);
+	std::optional<StatResult>	result = cachedStat(path);
+
+	if (!result)
+		return std::filesystem::exists(path);
+	// like std::filesystem::exists, only a missing file is not an error
+	if (result->error && result->error != ENOENT && result->error != ENOTDIR)
+		throw std::filesystem::filesystem_error("Can't stat file", path, std::error_code(result->error, std::generic_category()));
+	return result->exists;
 }
 
-Single<bool>	FileSystem::rxExists(const std::string& path)
+Single<bool>	FileSystem::rxExists(const std::string& path, const Schedulers& schedulers)
 {
-	return Single<bool>::defer([path]()
+	return dispatch(Single<bool>::defer([path]()
 	{
 		return Single<bool>::just(FileSystem::exists(path));
-	});
+	}), schedulers);
 }
 
 void			FileSystem::remove(const std::string& path)
 {
+	invalidateMetadata(path);
 	std::filesystem::remove(path);
 }
 
-Completable		FileSystem::rxRemove(const std::string& path)
+Completable		FileSystem::rxRemove(const std::string& path, const Schedulers& schedulers)
 {
-	return Completable::defer([path]()
+	return dispatch(Completable::defer([path]()
 	{
 		FileSystem::remove(path);
 		return Completable::complete();
-	});
+	}), schedulers);
 }
 
 void			FileSystem::removeRecursive(const std::string& path)
 {
+	invalidateMetadata(path);
 	std::filesystem::remove_all(path);
 }
 
-Completable		FileSystem::rxRemoveRecursive(const std::string& path)
+Completable		FileSystem::rxRemoveRecursive(const std::string& path, const Schedulers& schedulers)
 {
-	return Completable::defer([path]()
+	return dispatch(Completable::defer([path]()
 	{
 		FileSystem::removeRecursive(path);
 		return Completable::complete();
-	});
+	}), schedulers);
 }
 
 void			FileSystem::move(const std::string& oldPath, const std::string& newPath)
 {
+	invalidateMetadata(oldPath);
+	invalidateMetadata(newPath);
 	std::filesystem::rename(oldPath, newPath);
 }
 
-Completable		FileSystem::rxMove(const std::string& oldPath, const std::string& newPath)
+Observable<FileSystem::Progress>	FileSystem::rxRemoveRecursive(const std::string& path, size_t parallelism, const Schedulers& schedulers)
+{
+	if (!parallelism)
+		throw std::invalid_argument("parallelism must be greater than 0");
+
+	return dispatch(Observable<Progress>::createCancellable([path, parallelism](Observable<Progress>::SuccessFunction onNext, Observable<Progress>::CompleteFunction onComplete, Observable<Progress>::ErrorFunction onError) -> Observable<Progress>::CancelFunction
+	{
+		invalidateMetadata(path);
+#if defined(_WIN32)
+		try
+		{
+			uint64_t	removed = std::filesystem::remove_all(path);
+
+			onNext(Progress{ removed, 0, 0 });
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return nullptr;
+		}
+		onComplete();
+		return nullptr;
+#else
+		std::shared_ptr<TreeJob>	job = std::make_shared<TreeJob>(parallelism);
+		struct stat					status;
+
+		job->onNext = onNext;
+		job->onComplete = onComplete;
+		job->onError = onError;
+		// like remove_all, a missing path is not an error, and a file is simply removed
+		if (!lstat(path.c_str(), &status) && S_ISDIR(status.st_mode))
+		{
+			std::shared_ptr<RemovedDirectory>	root = std::make_shared<RemovedDirectory>();
+
+			root->path = path;
+			job->add([job, root]()
+			{
+				removeDirectory(job, root);
+			});
+			// unsubscribing stops the job
+			return [job]()
+			{
+				job->cancel();
+			};
+		}
+		if (!unlink(path.c_str()))
+			job->files++;
+		else if (errno != ENOENT)
+		{
+			onError(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "Can't remove " + path)));
+			return nullptr;
+		}
+		job->report(true);
+		onComplete();
+		return nullptr;
+#endif
+	}), schedulers);
+}
+
+Completable		FileSystem::rxMove(const std::string& oldPath, const std::string& newPath, const Schedulers& schedulers)
 {
-	return Completable::defer([oldPath, newPath]()
+	return dispatch(Completable::defer([oldPath, newPath]()
 	{
 		FileSystem::move(oldPath, newPath);
 		return Completable::complete();
-	});
+	}), schedulers);
 }
 
 void			FileSystem::mkdir(const std::string& path)
 {
+	invalidateMetadata(path);
 	std::filesystem::create_directory(path);
 }
 
-Completable		FileSystem::rxMkdir(const std::string& path)
+Completable		FileSystem::rxMkdir(const std::string& path, const Schedulers& schedulers)
 {
-	return Completable::defer([path]()
+	return dispatch(Completable::defer([path]()
 	{
 		FileSystem::mkdir(path);
 		return Completable::complete();
-	});
+	}), schedulers);
 }
 
 void			FileSystem::mkdirs(const std::string& path)
 {
+	invalidateMetadata(path);
 	std::filesystem::create_directories(path);
 }
 
-Completable		FileSystem::rxMkdirs(const std::string& path)
+Completable		FileSystem::rxMkdirs(const std::string& path, const Schedulers& schedulers)
 {
-	return Completable::defer([path]()
+	return dispatch(Completable::defer([path]()
 	{
 		FileSystem::mkdirs(path);
 		return Completable::complete();
-	});
+	}), schedulers);
+}
+
+Observable<FileSystem::Progress>	FileSystem::rxCopyRecursive(const std::string& source, const std::string& destination, size_t parallelism, const Schedulers& schedulers)
+{
+	if (!parallelism)
+		throw std::invalid_argument("parallelism must be greater than 0");
+
+	return dispatch(Observable<Progress>::createCancellable([source, destination, parallelism](Observable<Progress>::SuccessFunction onNext, Observable<Progress>::CompleteFunction onComplete, Observable<Progress>::ErrorFunction onError) -> Observable<Progress>::CancelFunction
+	{
+		invalidateMetadata(destination);
+#if defined(_WIN32)
+		try
+		{
+			std::filesystem::copy(source, destination, std::filesystem::copy_options::recursive | std::filesystem::copy_options::copy_symlinks | std::filesystem::copy_options::overwrite_existing);
+			onNext(Progress{ 0, 0, 0 });
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return nullptr;
+		}
+		onComplete();
+		return nullptr;
+#else
+		std::shared_ptr<TreeJob>	job = std::make_shared<TreeJob>(parallelism);
+		struct stat					status;
+
+		job->onNext = onNext;
+		job->onComplete = onComplete;
+		job->onError = onError;
+		if (lstat(source.c_str(), &status))
+		{
+			onError(std::make_exception_ptr(std::system_error(errno, std::generic_category(), "Can't copy " + source)));
+			return nullptr;
+		}
+		if (!S_ISDIR(status.st_mode))
+		{
+			try
+			{
+				if (S_ISLNK(status.st_mode))
+					copyLink(job, AT_FDCWD, source, status.st_size, AT_FDCWD, destination);
+				else
+					copyFile(job, AT_FDCWD, source, AT_FDCWD, destination);
+			}
+			catch (const std::exception&)
+			{
+				onError(std::current_exception());
+				return nullptr;
+			}
+			job->report(true);
+			onComplete();
+			return nullptr;
+		}
+		job->add([job, source, destination]()
+		{
+			copyDirectory(job, nullptr, source, destination);
+		});
+		// unsubscribing stops the job
+		return [job]()
+		{
+			job->cancel();
+		};
+#endif
+	}), schedulers);
 }
 
 size_t			FileSystem::fileSize(const std::string& path)
 {
-	return std::filesystem::file_size(path);
+	std::optional<StatResult>	result = cachedStat(path);
+
+	if (!result)
+		return std::filesystem::file_size(path);
+	// the same errors std::filesystem::file_size would report
+	if (result->error)
+		throw std::filesystem::filesystem_error("Can't get file size", path, std::error_code(result->error, std::generic_category()));
+	if (result->type == DirEntry::Type::DIRECTORY)
+		throw std::filesystem::filesystem_error("Can't get file size", path, std::make_error_code(std::errc::is_a_directory));
+	if (result->type != DirEntry::Type::FILE)
+		throw std::filesystem::filesystem_error("Can't get file size", path, std::make_error_code(std::errc::not_supported));
+	return static_cast<size_t>(result->size);
 }
 
-Single<size_t>	FileSystem::rxFileSize(const std::string& path)
+Single<size_t>	FileSystem::rxFileSize(const std::string& path, const Schedulers& schedulers)
 {
-	return Single<size_t>::defer([path]()
+	return dispatch(Single<size_t>::defer([path]()
 	{
 		return Single<size_t>::just(FileSystem::fileSize(path));
-	});
+	}), schedulers);
+}
+
+Observable<FileSystem::StatResult>	FileSystem::rxStatMany(const std::vector<std::string>& paths, const Schedulers& schedulers)
+{
+	return dispatch(Observable<StatResult>::create([paths](Observable<StatResult>::SuccessFunction onNext, Observable<StatResult>::CompleteFunction onComplete, Observable<StatResult>::ErrorFunction onError)
+	{
+		uint64_t								generation = metadataGeneration();
+		std::function<void(const StatResult&)>	onResult = [onNext, generation](const StatResult& result)
+		{
+			cacheStat(result, generation);
+			onNext(result);
+		};
+
+		try
+		{
+#if defined(__linux__) && defined(RXCW_ENABLE_IO_URING)
+			if (statBatches(paths, onResult))
+			{
+				onComplete();
+				return ;
+			}
+#endif
+			for (const std::string& path : paths)
+				onResult(statPath(path));
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return ;
+		}
+		onComplete();
+	}), schedulers);
+}
+
+Observable<Buffer>	FileSystem::rxReadChunks(const std::string& path, size_t chunkSize, size_t parallelism, const Schedulers& schedulers)
+{
+	if (!chunkSize || !parallelism)
+		throw std::invalid_argument("chunkSize and parallelism must be greater than 0");
+
+	return dispatch(Observable<Buffer>::createCancellable([path, chunkSize, parallelism](Observable<Buffer>::SuccessFunction onNext, Observable<Buffer>::CompleteFunction onComplete, Observable<Buffer>::ErrorFunction onError) -> Observable<Buffer>::CancelFunction
+	{
+		std::shared_ptr<ChunkReader>	reader = std::make_shared<ChunkReader>();
+
+		try
+		{
+			reader->file.reset(FileSystem::open(path, "r"));
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return nullptr;
+		}
+		reader->chunkSize = chunkSize;
+		reader->parallelism = parallelism;
+		reader->onNext = onNext;
+		reader->onComplete = onComplete;
+		reader->onError = onError;
+		reader->read();
+		return [reader]()
+		{
+			reader->cancel();
+		};
+	}), schedulers);
+}
+
+Observable<FileSystem::DirEntry>	FileSystem::rxList(const std::string& path, const Schedulers& schedulers)
+{
+	WalkOptions	options;
+
+	options.maxDepth = 1;
+	return rxWalk(path, options, schedulers);
+}
+
+Observable<FileSystem::DirEntry>	FileSystem::rxWalk(const std::string& path, const WalkOptions& options, const Schedulers& schedulers)
+{
+	if (!options.bufferSize)
+		throw std::invalid_argument("bufferSize must be greater than 0");
+
+	return dispatch(Observable<DirEntry>::createInterruptible([path, options](Observable<DirEntry>::SuccessFunction onNext, Observable<DirEntry>::CompleteFunction onComplete, Observable<DirEntry>::ErrorFunction onError, Observable<DirEntry>::SubscribedFunction subscribed)
+	{
+		try
+		{
+			walk(path, options, onNext, subscribed);
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return ;
+		}
+		onComplete();
+	}), schedulers);
+}
+
+Observable<FileSystem::FsEvent>	FileSystem::rxWatch(const std::string& path, uint32_t events, bool recursive, std::chrono::milliseconds debounce, const Schedulers& schedulers)
+{
+	return dispatch(Observable<FsEvent>::createCancellable([path, events, recursive, debounce](Observable<FsEvent>::SuccessFunction onNext, Observable<FsEvent>::CompleteFunction onComplete, Observable<FsEvent>::ErrorFunction onError) -> Observable<FsEvent>::CancelFunction
+	{
+#if defined(__linux__)
+		FileWatcher*	watcher;
+		uint64_t		id;
+
+		try
+		{
+			watcher = FileWatcher::get();
+			id = watcher->watch(path, events, recursive, debounce, [onNext](FsEvent event)
+			{
+				invalidateMetadata(event.path);
+				onNext(event);
+			}, onError, onComplete);
+		}
+		catch (const std::exception&)
+		{
+			onError(std::current_exception());
+			return nullptr;
+		}
+		return [watcher, id]()
+		{
+			watcher->unwatch(id);
+		};
+#else
+		onError(std::make_exception_ptr(std::runtime_error("rxWatch is only supported on Linux")));
+		return nullptr;
+#endif
+	}), schedulers);
+}
+
+std::optional<FileSystem::StatResult>	FileSystem::cachedStat(const std::string& path)
+{
+	std::chrono::steady_clock::time_point	now = std::chrono::steady_clock::now();
+	uint64_t								generation;
+
+	{
+		std::lock_guard<std::mutex>	lock(_metadataMutex);
+
+		if (!_metadataTtl.count())
+			return std::nullopt;
+
+		auto	it = _metadata.find(path);
+
+		if (it != _metadata.end() && it->second.expiry > now)
+		{
+			_recent.splice(_recent.begin(), _recent, it->second.recent);
+			return it->second.result;
+		}
+		if (it != _metadata.end())
+			dropStat(it);
+		generation = _metadataGeneration;
+	}
+
+	// the file is stated without the lock, concurrent misses on the same path just both refresh it
+	StatResult	result = statPath(path);
+
+	cacheStat(result, generation);
+	return result;
+}
+
+uint64_t								FileSystem::metadataGeneration()
+{
+	std::lock_guard<std::mutex>	lock(_metadataMutex);
+
+	return _metadataGeneration;
+}
+
+void									FileSystem::cacheStat(const StatResult& result, uint64_t generation)
+{
+	std::chrono::steady_clock::time_point	now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex>				lock(_metadataMutex);
+
+	// the path may have been changed while it was stated
+	if (!_metadataTtl.count() || generation != _metadataGeneration)
+		return ;
+
+	auto	it = _metadata.find(result.path);
+
+	if (it != _metadata.end())
+	{
+		it->second.result = result;
+		it->second.expiry = now + _metadataTtl;
+		_recent.splice(_recent.begin(), _recent, it->second.recent);
+		return ;
+	}
+	// make room by dropping the least recently used paths
+	while (_metadata.size() >= _metadataCacheSize)
+		dropStat(_metadata.find(_recent.back()));
+	_recent.push_front(result.path);
+	_metadata.emplace(result.path, CachedStat{ result, now + _metadataTtl, _recent.begin() });
+}
+
+std::map<std::string, FileSystem::CachedStat>::iterator	FileSystem::dropStat(std::map<std::string, CachedStat>::iterator it)
+{
+	_recent.erase(it->second.recent);
+	return _metadata.erase(it);
 }
@@ -0,0 +1,526 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: FileWatcher.cpp
+ * Created: 16th October 2026 4:12:37 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 4:12:37 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#if defined(__linux__)
+
+#include "RxCW/FileWatcher.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+// linux
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+std::mutex						FileWatcher::_instanceMutex;
+std::unique_ptr<FileWatcher>	FileWatcher::_instance;
+
+// every directory is watched for every change, each watch filters the ones it reports
+static const uint32_t	WATCH_MASK = IN_CREATE | IN_MODIFY | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_EXCL_UNLINK;
+
+static std::string	childPath(const std::string& parent, const std::string& name)
+{
+	if (!parent.empty() && parent.back() == '/')
+		return parent + name;
+	return parent + '/' + name;
+}
+
+static bool			isBelow(const std::string& path, const std::string& parent)
+{
+	return path.size() > parent.size() && !path.compare(0, parent.size(), parent) && (parent.back() == '/' || path[parent.size()] == '/');
+}
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+FileWatcher::FileWatcher(void)
+	: _fd(-1)
+	, _wakeFd(-1)
+	, _stopped(false)
+	, _nextId(0)
+{
+	_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (_fd < 0)
+		throw std::system_error(errno, std::generic_category(), "inotify_init1 failed");
+	_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (_wakeFd < 0)
+	{
+		int	error = errno;
+
+		close(_fd);
+		throw std::system_error(error, std::generic_category(), "eventfd failed");
+	}
+	_thread = std::thread(&FileWatcher::run, this);
+}
+
+FileWatcher::~FileWatcher(void)
+{
+	{
+		std::lock_guard<std::mutex>	lock(_mutex);
+
+		_stopped = true;
+	}
+	eventfd_write(_wakeFd, 1);
+	_thread.join();
+	close(_wakeFd);
+	close(_fd);
+}
+
+FileWatcher*	FileWatcher::get()
+{
+	std::lock_guard<std::mutex>	lock(_instanceMutex);
+
+	if (!_instance)
+		_instance.reset(new FileWatcher());
+	return _instance.get();
+}
+
+uint64_t		FileWatcher::watch(const std::string& path, uint32_t events, bool recursive, std::chrono::milliseconds debounce, const EventFunction& onEvent, const ErrorFunction& onError, const CompleteFunction& onComplete)
+{
+	std::shared_ptr<Watch>	watch = std::make_shared<Watch>();
+	struct stat				status;
+
+	watch->path = path;
+	while (watch->path.size() > 1 && watch->path.back() == '/')
+		watch->path.pop_back();
+	watch->events = events;
+	watch->recursive = recursive;
+	watch->debounce = debounce;
+	watch->onEvent = onEvent;
+	watch->onError = onError;
+	watch->onComplete = onComplete;
+	watch->active = true;
+	watch->ended = false;
+	if (stat(watch->path.c_str(), &status))
+		throw std::system_error(errno, std::generic_category(), "Can't watch " + path);
+	watch->directory = S_ISDIR(status.st_mode);
+
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	watch->id = _nextId++;
+	watch->root = inotify_add_watch(_fd, watch->path.c_str(), WATCH_MASK);
+	if (watch->root < 0)
+		throw std::system_error(errno, std::generic_category(), "Can't watch " + path);
+
+	WatchedDirectory&	directory = _directories[watch->root];
+
+	directory.path = watch->path;
+	directory.watches.insert(watch.get());
+	watch->directories.insert(watch->root);
+	_paths[watch->path] = watch->root;
+	try
+	{
+		if (recursive && watch->directory)
+			addDirectory(watch.get(), watch->path, false, std::chrono::steady_clock::now());
+	}
+	catch (const std::exception&)
+	{
+		detach(watch.get());
+		throw;
+	}
+	_watches[watch->id] = watch;
+	return watch->id;
+}
+
+void			FileWatcher::unwatch(uint64_t id)
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+	auto						it = _watches.find(id);
+
+	if (it == _watches.end())
+		return ;
+	it->second->active = false;
+	detach(it->second.get());
+	_watches.erase(it);
+}
+
+void			FileWatcher::run()
+{
+	std::unique_ptr<char[]>					buffer(new char[EVENT_BUFFER_SIZE]);
+	std::chrono::steady_clock::time_point	deadline = std::chrono::steady_clock::time_point::max();
+
+	while (true)
+	{
+		int		timeout = -1;
+		pollfd	fds[2] = { { _fd, POLLIN, 0 }, { _wakeFd, POLLIN, 0 } };
+
+		if (deadline != std::chrono::steady_clock::time_point::max())
+		{
+			std::chrono::steady_clock::duration	remaining = deadline - std::chrono::steady_clock::now();
+
+			// rounded up, so the deadline is passed when poll returns
+			timeout = static_cast<int>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(remaining + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1)).count()));
+		}
+		if (poll(fds, 2, timeout) < 0 && errno != EINTR)
+			return ;
+		if (fds[1].revents & POLLIN)
+		{
+			eventfd_t	value;
+
+			eventfd_read(_wakeFd, &value);
+		}
+
+		std::vector<Delivery>	deliveries;
+
+		{
+			std::lock_guard<std::mutex>				lock(_mutex);
+			std::chrono::steady_clock::time_point	now = std::chrono::steady_clock::now();
+			ssize_t									length;
+
+			if (_stopped)
+				return ;
+			while ((length = read(_fd, buffer.get(), EVENT_BUFFER_SIZE)) > 0)
+			{
+				for (ssize_t offset = 0; offset < length;)
+				{
+					const inotify_event*	event = reinterpret_cast<const inotify_event*>(buffer.get() + offset);
+
+					handle(event, now);
+					offset += sizeof(inotify_event) + event->len;
+				}
+			}
+			deadline = flush(now, deliveries);
+		}
+
+		// the functions are called without the lock, so they can watch or unwatch
+		for (Delivery& delivery : deliveries)
+		{
+			for (const FileSystem::FsEvent& event : delivery.events)
+				if (delivery.watch->active)
+					delivery.watch->onEvent(event);
+			if (!delivery.watch->active)
+				continue;
+			if (delivery.error)
+				delivery.watch->onError(delivery.error);
+			else if (delivery.complete)
+				delivery.watch->onComplete();
+		}
+	}
+}
+
+void			FileWatcher::handle(const inotify_event* event, std::chrono::steady_clock::time_point now)
+{
+	if (event->mask & IN_Q_OVERFLOW)
+	{
+		rescan(now);
+		return ;
+	}
+
+	auto	it = _directories.find(event->wd);
+
+	if (it == _directories.end())
+		return ;
+
+	// copied, as adding and removing directories may change the watches of this one
+	std::string			path = event->len ? childPath(it->second.path, event->name) : it->second.path;
+	std::set<Watch*>	watches = it->second.watches;
+	bool				directory = event->mask & IN_ISDIR;
+
+	if (event->mask & IN_IGNORED)
+	{
+		// the directory was removed, or is not watched anymore
+		for (Watch* watch : watches)
+		{
+			watch->directories.erase(event->wd);
+			if (watch->root == event->wd)
+				watch->ended = true;
+		}
+
+		auto	watched = _paths.find(it->second.path);
+
+		if (watched != _paths.end() && watched->second == event->wd)
+			_paths.erase(watched);
+		_directories.erase(it);
+		return ;
+	}
+
+	if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+	{
+		// the parent directory reports the changes of the others
+		for (Watch* watch : watches)
+		{
+			if (watch->root != event->wd)
+				continue;
+			report(watch, path, event->mask & IN_DELETE_SELF ? FileSystem::FsEvent::REMOVED : FileSystem::FsEvent::MOVED_FROM, watch->directory, now);
+			watch->ended = true;
+		}
+		return ;
+	}
+
+	uint32_t	types = 0;
+
+	if (event->mask & IN_CREATE)
+		types |= FileSystem::FsEvent::CREATED;
+	if (event->mask & IN_MODIFY)
+		types |= FileSystem::FsEvent::MODIFIED;
+	if (event->mask & IN_ATTRIB)
+		types |= FileSystem::FsEvent::ATTRIBUTES;
+	if (event->mask & IN_DELETE)
+		types |= FileSystem::FsEvent::REMOVED;
+	if (event->mask & IN_MOVED_FROM)
+		types |= FileSystem::FsEvent::MOVED_FROM;
+	if (event->mask & IN_MOVED_TO)
+		types |= FileSystem::FsEvent::MOVED_TO;
+
+	// a directory moved away is not part of the watched trees anymore
+	if (directory && (event->mask & IN_MOVED_FROM))
+		removeDirectories(watches, path);
+
+	for (Watch* watch : watches)
+	{
+		report(watch, path, types, directory, now);
+
+		// entries created before the new directory is watched are reported as created too
+		if (directory && watch->recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+		{
+			try
+			{
+				addDirectory(watch, path, event->mask & IN_CREATE, now);
+			}
+			catch (const std::exception&)
+			{
+				watch->error = std::current_exception();
+			}
+		}
+	}
+}
+
+void			FileWatcher::rescan(std::chrono::steady_clock::time_point now)
+{
+	for (auto it = _watches.begin(); it != _watches.end(); ++it)
+	{
+		Watch*	watch = it->second.get();
+
+		if (watch->ended || watch->error)
+			continue;
+		report(watch, watch->path, FileSystem::FsEvent::RESCAN, watch->directory, now);
+		if (!watch->recursive || !watch->directory)
+			continue;
+		// watches the directories created while the events were lost
+		try
+		{
+			addDirectory(watch, watch->path, false, now);
+		}
+		catch (const std::exception&)
+		{
+			watch->error = std::current_exception();
+		}
+	}
+}
+
+void			FileWatcher::addDirectory(Watch* watch, const std::string& path, bool scan, std::chrono::steady_clock::time_point now)
+{
+	int	wd = inotify_add_watch(_fd, path.c_str(), WATCH_MASK | IN_ONLYDIR);
+
+	if (wd < 0)
+	{
+		// removed, replaced or unreadable in the meantime
+		if (errno == ENOENT || errno == ENOTDIR || errno == EACCES)
+			return ;
+		throw std::system_error(errno, std::generic_category(), "Can't watch " + path);
+	}
+
+	WatchedDirectory&	directory = _directories[wd];
+
+	// a directory moved inside the tree keeps its watch, under its new path
+	if (directory.path != path)
+	{
+		auto	watched = _paths.find(directory.path);
+
+		if (watched != _paths.end() && watched->second == wd)
+			_paths.erase(watched);
+		directory.path = path;
+	}
+	directory.watches.insert(watch);
+	watch->directories.insert(wd);
+	_paths[path] = wd;
+
+	std::error_code						error;
+	std::filesystem::directory_iterator	it(path, error);
+
+	for (; !error && it != std::filesystem::directory_iterator(); it.increment(error))
+	{
+		bool		isDirectory = it->is_directory(error) && !it->is_symlink(error);
+		std::string	child = it->path().string();
+
+		if (scan)
+			report(watch, child, FileSystem::FsEvent::CREATED, isDirectory, now);
+		if (isDirectory)
+			addDirectory(watch, child, scan, now);
+	}
+}
+
+void			FileWatcher::removeDirectories(const std::set<Watch*>& watches, const std::string& path)
+{
+	std::vector<std::pair<std::string, int>>	removed;
+
+	for (auto it = _paths.lower_bound(path); it != _paths.end() && (it->first == path || isBelow(it->first, path)); ++it)
+		removed.push_back(*it);
+	for (const std::pair<std::string, int>& entry : removed)
+	{
+		WatchedDirectory&	directory = _directories[entry.second];
+
+		// the watches rooted in the moved directory keep watching it
+		for (Watch* watch : watches)
+		{
+			if (watch->root == entry.second)
+				continue;
+			directory.watches.erase(watch);
+			watch->directories.erase(entry.second);
+		}
+		if (!directory.watches.empty())
+			continue;
+		inotify_rm_watch(_fd, entry.second);
+		_directories.erase(entry.second);
+		_paths.erase(entry.first);
+	}
+}
+
+void			FileWatcher::detach(Watch* watch)
+{
+	for (int wd : watch->directories)
+	{
+		auto	it = _directories.find(wd);
+
+		if (it == _directories.end())
+			continue;
+		it->second.watches.erase(watch);
+		if (!it->second.watches.empty())
+			continue;
+
+		auto	watched = _paths.find(it->second.path);
+
+		if (watched != _paths.end() && watched->second == wd)
+			_paths.erase(watched);
+		inotify_rm_watch(_fd, wd);
+		_directories.erase(it);
+	}
+	watch->directories.clear();
+}
+
+void			FileWatcher::report(Watch* watch, const std::string& path, uint32_t types, bool directory, std::chrono::steady_clock::time_point now)
+{
+	// a rescan is always reported, the state it follows is unknown
+	types &= watch->events | FileSystem::FsEvent::RESCAN;
+	if (!types || watch->ended)
+		return ;
+
+	Pending&	pending = watch->pending.emplace(path, Pending{ FileSystem::FsEvent{ path, 0, directory }, now, now }).first->second;
+
+	pending.event.types |= types;
+	pending.event.directory = directory;
+	pending.last = now;
+}
+
+std::chrono::steady_clock::time_point	FileWatcher::flush(std::chrono::steady_clock::time_point now, std::vector<Delivery>& deliveries)
+{
+	std::chrono::steady_clock::time_point	deadline = std::chrono::steady_clock::time_point::max();
+
+	for (auto it = _watches.begin(); it != _watches.end();)
+	{
+		std::shared_ptr<Watch>	watch = it->second;
+		bool					terminated = watch->ended || watch->error;
+		std::vector<Pending>	ready;
+
+		for (auto pending = watch->pending.begin(); pending != watch->pending.end();)
+		{
+			// a path that keeps changing is still reported regularly
+			std::chrono::steady_clock::time_point	due = std::min(pending->second.last + watch->debounce, pending->second.first + watch->debounce * static_cast<int>(MAX_DEBOUNCE_FACTOR));
+
+			if (terminated || due <= now)
+			{
+				ready.push_back(pending->second);
+				pending = watch->pending.erase(pending);
+				continue;
+			}
+			deadline = std::min(deadline, due);
+			++pending;
+		}
+
+		if (!ready.empty() || terminated)
+		{
+			Delivery	delivery;
+
+			// emitted in the order the paths first changed
+			std::stable_sort(ready.begin(), ready.end(), [](const Pending& a, const Pending& b)
+			{
+				return a.first < b.first;
+			});
+			delivery.watch = watch;
+			for (const Pending& pending : ready)
+				delivery.events.push_back(pending.event);
+			delivery.complete = watch->ended;
+			delivery.error = watch->error;
+			deliveries.push_back(delivery);
+		}
+
+		if (!terminated)
+		{
+			++it;
+			continue;
+		}
+		detach(watch.get());
+		it = _watches.erase(it);
+	}
+	return deadline;
+}
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: IOScheduler.cpp
+ * Created: 16th October 2026 10:12:40 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 10:12:40 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/IOScheduler.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+std::mutex								IOScheduler::_mutex;
+size_t									IOScheduler::_threadCount = IOScheduler::DEFAULT_THREAD_COUNT;
+std::vector<rxcpp::schedulers::worker>	IOScheduler::_workers;
+size_t									IOScheduler::_next = 0;
+size_t									IOScheduler::_blockingThreadCount = IOScheduler::DEFAULT_BLOCKING_THREAD_COUNT;
+std::vector<rxcpp::schedulers::worker>	IOScheduler::_blockingWorkers;
+size_t									IOScheduler::_nextBlocking = 0;
+size_t									IOScheduler::_computeThreadCount = IOScheduler::DEFAULT_COMPUTE_THREAD_COUNT;
+std::vector<rxcpp::schedulers::worker>	IOScheduler::_computeWorkers;
+size_t									IOScheduler::_nextCompute = 0;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+IOScheduler::IOScheduler(void)
+{
+}
+
+IOScheduler::~IOScheduler(void)
+{
+}
+
+void							IOScheduler::setThreadCount(size_t count)
+{
+	if (!count)
+		throw std::invalid_argument("count must be greater than 0");
+
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	if (!_workers.empty())
+		throw std::logic_error("thread count can't be changed once the pool is started");
+
+	_threadCount = count;
+}
+
+size_t							IOScheduler::threadCount()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return _threadCount;
+}
+
+rxcpp::schedulers::scheduler	IOScheduler::scheduler()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return next(_workers, _threadCount, _next);
+}
+
+void							IOScheduler::setBlockingThreadCount(size_t count)
+{
+	if (!count)
+		throw std::invalid_argument("count must be greater than 0");
+
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	if (!_blockingWorkers.empty())
+		throw std::logic_error("thread count can't be changed once the pool is started");
+
+	_blockingThreadCount = count;
+}
+
+size_t							IOScheduler::blockingThreadCount()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return _blockingThreadCount;
+}
+
+rxcpp::schedulers::scheduler	IOScheduler::blockingScheduler()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return next(_blockingWorkers, _blockingThreadCount, _nextBlocking);
+}
+
+void							IOScheduler::setComputeThreadCount(size_t count)
+{
+	if (!count)
+		throw std::invalid_argument("count must be greater than 0");
+
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	if (!_computeWorkers.empty())
+		throw std::logic_error("thread count can't be changed once the pool is started");
+
+	_computeThreadCount = count;
+}
+
+size_t							IOScheduler::computeThreadCount()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return _computeThreadCount;
+}
+
+rxcpp::schedulers::scheduler	IOScheduler::computeScheduler()
+{
+	std::lock_guard<std::mutex>	lock(_mutex);
+
+	return next(_computeWorkers, _computeThreadCount, _nextCompute);
+}
+
+rxcpp::schedulers::scheduler	IOScheduler::next(std::vector<rxcpp::schedulers::worker>& workers, size_t count, size_t& index)
+{
+	// threads are only started on first use
+	if (workers.empty())
+	{
+		rxcpp::schedulers::scheduler	newThread = rxcpp::schedulers::make_new_thread();
+
+		for (size_t i = 0; i < count; i++)
+			workers.push_back(newThread.create_worker());
+	}
+
+	return rxcpp::schedulers::make_same_worker(workers[index++ % workers.size()]);
+}
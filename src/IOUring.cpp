@@ -0,0 +1,361 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: IOUring.cpp
+ * Created: 16th October 2026 11:02:25 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:02:25 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#if defined(RXCW_ENABLE_IO_URING)
+
+#include "RxCW/IOUring.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include "RxCW/IOScheduler.h"
+
+// stl
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+// linux
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+************
+** static **
+************
+*/
+
+std::mutex								IOUring::_poolMutex;
+bool									IOUring::_poolInitialized = false;
+std::vector<std::unique_ptr<IOUring>>	IOUring::_pool;
+size_t									IOUring::_next = 0;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+IOUring::IOUring(unsigned entries)
+	: _pending(0)
+	, _sqRing(MAP_FAILED)
+	, _cqRing(MAP_FAILED)
+	, _sqes(nullptr)
+{
+	io_uring_params	params;
+
+	std::memset(&params, 0, sizeof(params));
+	_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+	if (_fd < 0)
+		throw std::system_error(errno, std::generic_category(), "io_uring_setup failed");
+
+	// reading and writing at the current file position requires linux 5.6
+	if (!(params.features & IORING_FEAT_RW_CUR_POS))
+	{
+		close(_fd);
+		throw std::runtime_error("io_uring does not support reading at the current file position");
+	}
+
+	_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+	{
+		_sqRingSize = std::max(_sqRingSize, _cqRingSize);
+		_cqRingSize = _sqRingSize;
+	}
+
+	_sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+	if (params.features & IORING_FEAT_SINGLE_MMAP)
+		_cqRing = _sqRing;
+	else if (_sqRing != MAP_FAILED)
+		_cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+	void*	sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+
+	if (_sqRing == MAP_FAILED || _cqRing == MAP_FAILED || sqes == MAP_FAILED)
+	{
+		int	error = errno;
+
+		if (sqes != MAP_FAILED)
+			munmap(sqes, _sqesSize);
+		if (_cqRing != MAP_FAILED && _cqRing != _sqRing)
+			munmap(_cqRing, _cqRingSize);
+		if (_sqRing != MAP_FAILED)
+			munmap(_sqRing, _sqRingSize);
+		close(_fd);
+		throw std::system_error(error, std::generic_category(), "io_uring mmap failed");
+	}
+
+	_sqes = static_cast<io_uring_sqe*>(sqes);
+
+	char*	sqRing = static_cast<char*>(_sqRing);
+	_sqHead = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+	_sqTail = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+	_sqMask = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+	_sqEntries = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_entries);
+	_sqArray = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+
+	char*	cqRing = static_cast<char*>(_cqRing);
+	_cqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+	_cqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+	_cqMask = *reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+	_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+	_thread = std::thread(&IOUring::run, this);
+}
+
+IOUring::~IOUring(void)
+{
+	{
+		std::unique_lock<std::mutex>	lock(_mutex);
+
+		// a request without completion function stops the completion thread
+		prepare(lock, IORING_OP_NOP, -1, nullptr, 0, 0, nullptr);
+		submit(lock);
+	}
+	_thread.join();
+
+	munmap(_sqes, _sqesSize);
+	if (_cqRing != _sqRing)
+		munmap(_cqRing, _cqRingSize);
+	munmap(_sqRing, _sqRingSize);
+	close(_fd);
+}
+
+IOUring*	IOUring::get()
+{
+	std::lock_guard<std::mutex>	lock(_poolMutex);
+
+	if (!_poolInitialized)
+	{
+		_poolInitialized = true;
+		try
+		{
+			for (size_t i = 0; i < IOScheduler::threadCount(); i++)
+				_pool.emplace_back(new IOUring(DEFAULT_QUEUE_DEPTH));
+		}
+		catch (const std::exception&)
+		{
+			// io_uring unavailable, AsyncFile falls back to stdio
+			_pool.clear();
+		}
+	}
+
+	if (_pool.empty())
+		return nullptr;
+
+	return _pool[_next++ % _pool.size()].get();
+}
+
+void		IOUring::read(int fd, void* data, size_t size, uint64_t offset, const CompletionFunction& onComplete)
+{
+	std::unique_ptr<CompletionFunction>	function(new CompletionFunction(onComplete));
+	std::unique_lock<std::mutex>		lock(_mutex);
+
+	prepare(lock, IORING_OP_READ, fd, data, size, offset, function.get());
+	function.release();
+	// requests prepared by other threads in the meantime are submitted at once
+	submit(lock);
+}
+
+void		IOUring::write(int fd, const void* data, size_t size, uint64_t offset, const CompletionFunction& onComplete)
+{
+	std::unique_ptr<CompletionFunction>	function(new CompletionFunction(onComplete));
+	std::unique_lock<std::mutex>		lock(_mutex);
+
+	prepare(lock, IORING_OP_WRITE, fd, data, size, offset, function.get());
+	function.release();
+	// requests prepared by other threads in the meantime are submitted at once
+	submit(lock);
+}
+
+void		IOUring::writev(int fd, const iovec* vector, size_t count, uint64_t offset, const CompletionFunction& onComplete)
+{
+	std::unique_ptr<CompletionFunction>	function(new CompletionFunction(onComplete));
+	std::unique_lock<std::mutex>		lock(_mutex);
+
+	prepare(lock, IORING_OP_WRITEV, fd, vector, count, offset, function.get());
+	function.release();
+	// requests prepared by other threads in the meantime are submitted at once
+	submit(lock);
+}
+
+void		IOUring::stat(const std::vector<StatRequest>& requests)
+{
+	std::unique_lock<std::mutex>	lock(_mutex);
+
+	for (const StatRequest& request : requests)
+	{
+		std::unique_ptr<CompletionFunction>	function(new CompletionFunction(request.onComplete));
+
+		// statx takes the mask as length and the result buffer as offset
+		prepare(lock, IORING_OP_STATX, request.dirfd, request.path, request.mask, reinterpret_cast<uintptr_t>(request.buffer), function.get(), static_cast<uint32_t>(request.flags));
+		function.release();
+	}
+	submit(lock);
+}
+
+void		IOUring::prepare(std::unique_lock<std::mutex>& lock, uint8_t opcode, int fd, const void* data, size_t size, uint64_t offset, CompletionFunction* onComplete, uint32_t flags)
+{
+	// submission queue full, submit pending requests to make room
+	while (*_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == _sqEntries)
+	{
+		submit(lock);
+		// the completion thread can't wait for room, its requests are failed rather than waiting for itself
+		if (*_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == _sqEntries && std::this_thread::get_id() == _thread.get_id())
+			fail(lock, EBUSY);
+	}
+
+	unsigned	tail = *_sqTail;
+
+	unsigned		index = tail & _sqMask;
+	io_uring_sqe*	sqe = &_sqes[index];
+
+	std::memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = opcode;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<uintptr_t>(data);
+	// linux never transfers more than 0x7ffff000 bytes at once
+	sqe->len = static_cast<uint32_t>(std::min<size_t>(size, 0x7ffff000));
+	sqe->off = offset;
+	sqe->rw_flags = flags;
+	sqe->user_data = reinterpret_cast<uintptr_t>(onComplete);
+	_sqArray[index] = index;
+
+	__atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+	_pending++;
+}
+
+void		IOUring::submit(std::unique_lock<std::mutex>& lock)
+{
+	while (_pending)
+	{
+		int	result = static_cast<int>(syscall(__NR_io_uring_enter, _fd, _pending, 0, 0, nullptr, 0));
+
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno == EAGAIN || errno == EBUSY)
+			{
+				// the completion thread submits the requests itself once it reaped some entries
+				if (std::this_thread::get_id() == _thread.get_id())
+					return ;
+				// completion queue is full, let the completion thread reap some entries, and the other threads prepare theirs
+				lock.unlock();
+				std::this_thread::yield();
+				lock.lock();
+				continue;
+			}
+			fail(lock, errno);
+			return ;
+		}
+		_pending -= static_cast<unsigned>(result);
+	}
+}
+
+void		IOUring::fail(std::unique_lock<std::mutex>& lock, int error)
+{
+	unsigned											tail = *_sqTail;
+	std::vector<std::unique_ptr<CompletionFunction>>	functions;
+
+	// the kernel didn't consume the pending entries, they are taken back so that they never complete later
+	for (unsigned index = tail - _pending; index != tail; index++)
+		functions.emplace_back(reinterpret_cast<CompletionFunction*>(_sqes[_sqArray[index & _sqMask]].user_data));
+	__atomic_store_n(_sqTail, tail - _pending, __ATOMIC_RELEASE);
+	_pending = 0;
+
+	// the functions may prepare new requests
+	lock.unlock();
+	for (const std::unique_ptr<CompletionFunction>& function : functions)
+	{
+		if (function)
+			(*function)(-error);
+	}
+	lock.lock();
+}
+
+void		IOUring::run()
+{
+	bool	stopped = false;
+
+	while (!stopped)
+	{
+		{
+			std::unique_lock<std::mutex>	lock(_mutex);
+
+			// requests prepared by the completion functions while the completion queue was full
+			submit(lock);
+		}
+
+		int	result = static_cast<int>(syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+
+		if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+			return;
+
+		unsigned	head = *_cqHead;
+		unsigned	tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+
+		while (head != tail)
+		{
+			io_uring_cqe*						cqe = &_cqes[head & _cqMask];
+			std::unique_ptr<CompletionFunction>	onComplete(reinterpret_cast<CompletionFunction*>(cqe->user_data));
+			ssize_t								res = cqe->res;
+
+			// release the entry before calling the function so it can submit new requests
+			__atomic_store_n(_cqHead, ++head, __ATOMIC_RELEASE);
+
+			if (onComplete)
+				(*onComplete)(res);
+			else
+				stopped = true;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,312 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: RecordReadStream.cpp
+ * Created: 16th October 2026 11:48:27 am
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 11:48:27 am
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/RecordReadStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include "RxCW/BufferPool.h"
+
+// stl
+#include <cstring>
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+RecordReadStream::RecordReadStream(ReadStream<Buffer>& source, char delimiter, size_t maxRecordSize)
+	: _source(source)
+	, _lengthPrefixed(false)
+	, _delimiter(delimiter)
+	, _maxRecordSize(maxRecordSize)
+	, _paused(true)
+	, _sourceEnded(false)
+	, _ended(false)
+	, _partsSize(0)
+	, _headerSize(0)
+	, _recordSize(Buffer::npos)
+{
+	listen();
+}
+
+RecordReadStream::RecordReadStream(ReadStream<Buffer>& source, const LengthPrefix& lengthPrefix, size_t maxRecordSize)
+	: _source(source)
+	, _lengthPrefixed(true)
+	, _delimiter(0)
+	, _lengthPrefix(lengthPrefix)
+	, _maxRecordSize(maxRecordSize)
+	, _paused(true)
+	, _sourceEnded(false)
+	, _ended(false)
+	, _partsSize(0)
+	, _headerSize(0)
+	, _recordSize(Buffer::npos)
+{
+	if (!lengthPrefix.size || lengthPrefix.size > sizeof(_header))
+		throw std::invalid_argument("length prefix size must be between 1 and " + std::to_string(sizeof(_header)));
+	listen();
+}
+
+RecordReadStream::~RecordReadStream(void)
+{
+}
+
+void	RecordReadStream::exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler)
+{
+	_errorHandler = handler;
+}
+
+void	RecordReadStream::endHandler(const ReadStream<Buffer>::EndFunction& handler)
+{
+	_endHandler = handler;
+}
+
+void	RecordReadStream::handler(const ReadStream<Buffer>::DataFunction& handler)
+{
+	_dataHandler = handler;
+}
+
+void	RecordReadStream::pause()
+{
+	_paused = true;
+	_source.pause();
+}
+
+void	RecordReadStream::resume()
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_paused = false;
+	// records left from the last chunks come first
+	process();
+	if (!_paused && !_sourceEnded)
+		_source.resume();
+}
+
+void	RecordReadStream::emit(const Buffer& record)
+{
+	if (_dataHandler)
+		_dataHandler(record);
+}
+
+void	RecordReadStream::listen()
+{
+	_source.handler([this](const Buffer& chunk)
+		{
+			std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+			if (_ended || chunk.empty())
+				return ;
+			_backlog.push_back(chunk);
+			process();
+		});
+	_source.endHandler([this]()
+		{
+			std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+			_sourceEnded = true;
+			process();
+		});
+	_source.exceptionHandler([this](std::exception_ptr exception)
+		{
+			std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+			fail(exception);
+		});
+}
+
+void	RecordReadStream::process()
+{
+	// a single record per iteration, so that a pause from the handler is honored right away
+	while (!_paused && !_ended && !_backlog.empty())
+	{
+		Buffer&	chunk = _backlog.front();
+		size_t	consumed = _lengthPrefixed ? frameLength(chunk) : frameDelimited(chunk);
+
+		if (_ended)
+			return ;
+		if (consumed < chunk.size())
+			chunk = chunk.slice(consumed);
+		else
+			_backlog.pop_front();
+	}
+
+	if (!_paused && !_ended && _backlog.empty() && _sourceEnded)
+		finish();
+}
+
+size_t	RecordReadStream::frameDelimited(const Buffer& chunk)
+{
+	const char*	delimiter = static_cast<const char*>(std::memchr(chunk.data(), _delimiter, chunk.size()));
+
+	if (!delimiter)
+	{
+		append(chunk);
+		return chunk.size();
+	}
+
+	size_t	size = static_cast<size_t>(delimiter - chunk.data());
+
+	if (_partsSize + size > _maxRecordSize)
+	{
+		fail(std::make_exception_ptr(std::length_error("record exceeds " + std::to_string(_maxRecordSize) + " bytes")));
+		return size;
+	}
+	emit(take(chunk.slice(0, size)));
+	return size + 1;
+}
+
+size_t	RecordReadStream::frameLength(const Buffer& chunk)
+{
+	if (_recordSize == Buffer::npos)
+	{
+		size_t	size = std::min(_lengthPrefix.size - _headerSize, chunk.size());
+
+		std::memcpy(_header + _headerSize, chunk.data(), size);
+		_headerSize += size;
+		if (_headerSize < _lengthPrefix.size)
+			return size;
+
+		uint64_t	length = 0;
+
+		for (size_t i = 0; i < _lengthPrefix.size; i++)
+		{
+			size_t	index = _lengthPrefix.bigEndian ? i : _lengthPrefix.size - 1 - i;
+
+			length = (length << 8) | _header[index];
+		}
+		_headerSize = 0;
+		if (length > _maxRecordSize)
+		{
+			fail(std::make_exception_ptr(std::length_error("record exceeds " + std::to_string(_maxRecordSize) + " bytes")));
+			return size;
+		}
+		if (!length)
+			emit(Buffer());
+		else
+			_recordSize = static_cast<size_t>(length);
+		return size;
+	}
+
+	size_t	needed = _recordSize - _partsSize;
+
+	if (chunk.size() < needed)
+	{
+		append(chunk);
+		return chunk.size();
+	}
+	_recordSize = Buffer::npos;
+	emit(take(chunk.slice(0, needed)));
+	return needed;
+}
+
+void	RecordReadStream::append(const Buffer& data)
+{
+	if (_partsSize + data.size() > _maxRecordSize)
+	{
+		fail(std::make_exception_ptr(std::length_error("record exceeds " + std::to_string(_maxRecordSize) + " bytes")));
+		return ;
+	}
+	_parts.push_back(data);
+	_partsSize += data.size();
+}
+
+Buffer	RecordReadStream::take(const Buffer& last)
+{
+	if (_parts.empty())
+		return last;
+	if (_parts.size() == 1 && last.empty())
+	{
+		Buffer	record = _parts.front();
+
+		_parts.clear();
+		_partsSize = 0;
+		return record;
+	}
+
+	// the record spans several chunks, gather them once
+	Buffer	record = BufferPool::acquire(_partsSize + last.size());
+	size_t	offset = 0;
+
+	for (const Buffer& part : _parts)
+	{
+		std::memcpy(record.data() + offset, part.data(), part.size());
+		offset += part.size();
+	}
+	if (!last.empty())
+		std::memcpy(record.data() + offset, last.data(), last.size());
+	_parts.clear();
+	_partsSize = 0;
+	return record;
+}
+
+void	RecordReadStream::fail(std::exception_ptr exception)
+{
+	_ended = true;
+	_backlog.clear();
+	_parts.clear();
+	_partsSize = 0;
+	_source.pause();
+	if (_errorHandler)
+		_errorHandler(exception);
+}
+
+void	RecordReadStream::finish()
+{
+	if (_lengthPrefixed && (_headerSize || _recordSize != Buffer::npos))
+	{
+		fail(std::make_exception_ptr(std::runtime_error("stream ended in the middle of a record")));
+		return ;
+	}
+
+	// the last record has no delimiter
+	if (!_lengthPrefixed && _partsSize)
+		emit(take(Buffer()));
+	_ended = true;
+	if (_endHandler)
+		_endHandler();
+}
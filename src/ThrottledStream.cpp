@@ -0,0 +1,174 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: ThrottledStream.cpp
+ * Created: 16th October 2026 2:31:08 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 2:31:08 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/ThrottledStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// RxCW
+#include "RxCW/IOScheduler.h"
+
+// stl
+#include <algorithm>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+ThrottledStream::ThrottledStream(size_t bytesPerSecond, size_t operationsPerSecond)
+	: _bytesPerSecond(bytesPerSecond)
+	, _operationsPerSecond(operationsPerSecond)
+	, _byteTokens(static_cast<double>(bytesPerSecond))
+	, _operationTokens(static_cast<double>(operationsPerSecond))
+	, _refilled(std::chrono::steady_clock::now())
+	, _timerScheduled(false)
+	, _flushing(false)
+	, _worker(IOScheduler::scheduler().create_worker(_lifetime))
+{
+}
+
+ThrottledStream::~ThrottledStream(void)
+{
+	// a timer running on another thread pins the stream, revoking the token waits for it to return
+	revoke();
+	_lifetime.unsubscribe();
+}
+
+void			ThrottledStream::setRates(size_t bytesPerSecond, size_t operationsPerSecond)
+{
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		refill();
+		_bytesPerSecond = bytesPerSecond;
+		_operationsPerSecond = operationsPerSecond;
+		_byteTokens = std::min(_byteTokens, static_cast<double>(_bytesPerSecond));
+		_operationTokens = std::min(_operationTokens, static_cast<double>(_operationsPerSecond));
+		release();
+	}
+	deliver();
+}
+
+void			ThrottledStream::transform(const Buffer& data)
+{
+	_waiting.push_back(data);
+	release();
+}
+
+void			ThrottledStream::flush()
+{
+	_flushing = true;
+	release();
+}
+
+bool			ThrottledStream::busy()
+{
+	return !_waiting.empty();
+}
+
+void			ThrottledStream::refill()
+{
+	std::chrono::steady_clock::time_point	now = std::chrono::steady_clock::now();
+	double									elapsed = std::chrono::duration<double>(now - _refilled).count();
+
+	_refilled = now;
+	_byteTokens = std::min(_byteTokens + elapsed * _bytesPerSecond, static_cast<double>(_bytesPerSecond));
+	_operationTokens = std::min(_operationTokens + elapsed * _operationsPerSecond, static_cast<double>(_operationsPerSecond));
+}
+
+void			ThrottledStream::release()
+{
+	double	wait = 0;
+
+	refill();
+	while (!_waiting.empty())
+	{
+		double	size = static_cast<double>(_waiting.front().size());
+
+		// wait until the buckets are full enough, or full if the chunk is larger than them
+		if (_bytesPerSecond && _byteTokens < std::min(size, static_cast<double>(_bytesPerSecond)))
+			wait = std::max(wait, (std::min(size, static_cast<double>(_bytesPerSecond)) - _byteTokens) / _bytesPerSecond);
+		if (_operationsPerSecond && _operationTokens < 1)
+			wait = std::max(wait, (1 - _operationTokens) / _operationsPerSecond);
+		if (wait > 0)
+			break;
+
+		Buffer	data = _waiting.front();
+
+		_waiting.pop_front();
+		if (_bytesPerSecond)
+			_byteTokens -= size;
+		if (_operationsPerSecond)
+			_operationTokens -= 1;
+		push(data);
+	}
+	drained();
+
+	if (_waiting.empty())
+	{
+		if (_flushing)
+			finish();
+		return ;
+	}
+	if (_timerScheduled)
+		return ;
+	std::shared_ptr<Token>	token = _token;
+
+	_timerScheduled = true;
+	_worker.schedule(_worker.now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(wait)), [this, token](const rxcpp::schedulers::schedulable&)
+	{
+		Pin	pin(token);
+
+		if (!pin)
+			return ;
+		{
+			std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+			_timerScheduled = false;
+			release();
+		}
+		deliver();
+	});
+}
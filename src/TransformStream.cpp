@@ -0,0 +1,351 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2022 paul ribault
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * File: TransformStream.cpp
+ * Created: 16th October 2026 12:31:09 pm
+ * Author: Paul Ribault (pribault.dev@gmail.com)
+ * 
+ * Last Modified: 16th October 2026 12:31:09 pm
+ * Modified By: Paul Ribault (pribault.dev@gmail.com)
+ */
+
+#include "RxCW/TransformStream.h"
+
+/*
+**************
+** includes **
+**************
+*/
+
+// stl
+#include <algorithm>
+#include <stdexcept>
+
+/*
+****************
+** namespaces **
+****************
+*/
+
+using namespace RxCW;
+
+/*
+********************************************************************************
+************************************ METHODS ***********************************
+********************************************************************************
+*/
+
+TransformStream::TransformStream(void)
+	: _token(std::make_shared<Token>())
+	, _paused(true)
+	, _writeEnded(false)
+	, _finished(false)
+	, _ended(false)
+	, _full(false)
+	, _drainPending(false)
+	, _delivering(false)
+	, _writeQueueSize(DEFAULT_WRITE_QUEUE_SIZE)
+{
+}
+
+TransformStream::~TransformStream(void)
+{
+	revoke();
+}
+
+void		TransformStream::exceptionHandler(const StreamBase<Buffer>::ErrorFunction& handler)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_errorHandler = handler;
+}
+
+void		TransformStream::endHandler(const ReadStream<Buffer>::EndFunction& handler)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_endHandler = handler;
+}
+
+void		TransformStream::handler(const ReadStream<Buffer>::DataFunction& handler)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_dataHandler = handler;
+}
+
+void		TransformStream::pause()
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_paused = true;
+}
+
+void		TransformStream::resume()
+{
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		_paused = false;
+	}
+	deliver();
+}
+
+void		TransformStream::drainHandler(const WriteStream<Buffer>::DrainFunction& handler)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_drainHandler = handler;
+}
+
+void		TransformStream::end()
+{
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		if (_writeEnded)
+			return ;
+		_writeEnded = true;
+		if (!_ended)
+			flush();
+	}
+	deliver();
+}
+
+void		TransformStream::write(const Buffer& data)
+{
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		if (_writeEnded)
+			throw std::logic_error("can't write to an ended stream");
+		// a failed stream drops the data, the failure was already reported
+		if (!_ended)
+			transform(data);
+	}
+	deliver();
+}
+
+void		TransformStream::setWriteQueueMaxSize(size_t size)
+{
+	if (!size)
+		throw std::invalid_argument("size must be greater than 0");
+
+	{
+		std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+		_writeQueueSize = size;
+		drained();
+	}
+	deliver();
+}
+
+bool		TransformStream::writeQueueFull()
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	if (_output.size() >= _writeQueueSize || busy())
+		_full = true;
+	return _full;
+}
+
+void		TransformStream::flush()
+{
+	finish();
+}
+
+void		TransformStream::push(const Buffer& data)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	if (data.empty() || _ended)
+		return ;
+	_output.push_back(data);
+}
+
+void		TransformStream::finish()
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_finished = true;
+}
+
+void		TransformStream::fail(std::exception_ptr exception)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	if (_ended)
+		return ;
+	_ended = true;
+	_output.clear();
+	_failure = exception;
+	failed(exception);
+}
+
+void		TransformStream::failed(std::exception_ptr)
+{
+}
+
+void		TransformStream::defer(const std::function<void()>& call)
+{
+	std::lock_guard<std::recursive_mutex>	lock(_mutex);
+
+	_deferred.push_back(call);
+}
+
+bool		TransformStream::busy()
+{
+	return false;
+}
+
+void		TransformStream::drained()
+{
+	if (_full && _output.size() < _writeQueueSize && !busy())
+	{
+		_full = false;
+		_drainPending = true;
+	}
+}
+
+void		TransformStream::deliver()
+{
+	// outlives the stream if a handler destroys it
+	std::shared_ptr<Token>					token = _token;
+	std::unique_lock<std::recursive_mutex>	lock(_mutex);
+
+	if (_delivering)
+		return ;
+	_delivering = true;
+	try
+	{
+		// the handlers may pause the stream, or write more data, the state is checked again after each call
+		while (true)
+		{
+			if (_failure)
+			{
+				std::exception_ptr					exception = _failure;
+				StreamBase<Buffer>::ErrorFunction	handler = _errorHandler;
+
+				_failure = nullptr;
+				lock.unlock();
+				if (handler)
+					handler(exception);
+			}
+			else if (!_deferred.empty())
+			{
+				std::function<void()>	call = _deferred.front();
+
+				_deferred.pop_front();
+				lock.unlock();
+				call();
+			}
+			else if (!_paused && !_ended && !_output.empty())
+			{
+				Buffer								data = _output.front();
+				ReadStream<Buffer>::DataFunction	handler = _dataHandler;
+
+				_output.pop_front();
+				drained();
+				lock.unlock();
+				if (handler)
+					handler(data);
+			}
+			else if (_drainPending)
+			{
+				WriteStream<Buffer>::DrainFunction	handler = _drainHandler;
+
+				_drainPending = false;
+				lock.unlock();
+				if (handler)
+					handler();
+			}
+			else if (!_paused && !_ended && _finished)
+			{
+				ReadStream<Buffer>::EndFunction	handler = _endHandler;
+
+				_ended = true;
+				lock.unlock();
+				if (handler)
+					handler();
+			}
+			else
+				break;
+			if (!token->alive)
+				return ;
+			lock.lock();
+		}
+	}
+	catch (...)
+	{
+		if (!token->alive)
+			throw;
+		if (!lock.owns_lock())
+			lock.lock();
+		_delivering = false;
+		throw;
+	}
+	_delivering = false;
+}
+
+void		TransformStream::revoke()
+{
+	std::unique_lock<std::mutex>	lock(_token->mutex);
+	std::thread::id					self = std::this_thread::get_id();
+
+	_token->alive = false;
+	_token->unpinned.wait(lock, [this, self]()
+	{
+		return std::all_of(_token->pins.begin(), _token->pins.end(), [self](const std::thread::id& pin)
+		{
+			return pin == self;
+		});
+	});
+}
+
+TransformStream::Pin::Pin(const std::shared_ptr<Token>& token)
+	: _token(token)
+	, _pinned(false)
+{
+	std::lock_guard<std::mutex>	lock(_token->mutex);
+
+	if (!_token->alive)
+		return ;
+	_token->pins.push_back(std::this_thread::get_id());
+	_pinned = true;
+}
+
+TransformStream::Pin::~Pin(void)
+{
+	if (!_pinned)
+		return ;
+
+	std::lock_guard<std::mutex>	lock(_token->mutex);
+
+	_token->pins.erase(std::find(_token->pins.begin(), _token->pins.end(), std::this_thread::get_id()));
+	_token->unpinned.notify_all();
+}
+
+TransformStream::Pin::operator bool() const
+{
+	return _pinned;
+}